@@ -0,0 +1,97 @@
+#include "arena.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define ARENA_BLOCO_PADRAO (64 * 1024)
+#define ARENA_ALINHAMENTO  (sizeof(void *))
+
+struct BlocoArena {
+    BlocoArena *anterior;    /* blocos formam uma pilha               */
+    size_t      tamanho;     /* bytes úteis em dados[]                */
+    size_t      livre;       /* deslocamento do primeiro byte livre   */
+    size_t      ultimo;      /* deslocamento da última alocação       */
+    char        dados[];
+};
+
+static size_t alinha(size_t n) {
+    return (n + ARENA_ALINHAMENTO - 1) & ~(ARENA_ALINHAMENTO - 1);
+}
+
+static BlocoArena *novo_bloco(size_t tamanho, BlocoArena *anterior) {
+    BlocoArena *b = malloc(sizeof(BlocoArena) + tamanho);
+    if (!b) {
+        fprintf(stderr, "ERRO: memória insuficiente na arena.\n");
+        exit(1);
+    }
+    b->anterior = anterior;
+    b->tamanho = tamanho;
+    b->livre = 0;
+    b->ultimo = 0;
+    return b;
+}
+
+void arena_inicia(Arena *a, size_t tam_bloco) {
+    a->atual = NULL;
+    a->tam_bloco = tam_bloco ? tam_bloco : ARENA_BLOCO_PADRAO;
+    a->usado = 0;
+}
+
+void *arena_aloca(Arena *a, size_t n) {
+    n = alinha(n ? n : 1);
+    BlocoArena *b = a->atual;
+    if (!b || b->tamanho - b->livre < n) {
+        /* pedidos maiores que o bloco padrão ganham um bloco próprio */
+        size_t tam = n > a->tam_bloco ? n : a->tam_bloco;
+        b = a->atual = novo_bloco(tam, b);
+    }
+    void *p = b->dados + b->livre;
+    b->ultimo = b->livre;
+    b->livre += n;
+    a->usado += n;
+    return p;
+}
+
+char *arena_strdup(Arena *a, const char *s) {
+    size_t n = strlen(s) + 1;
+    char *p = arena_aloca(a, n);
+    memcpy(p, s, n);
+    return p;
+}
+
+void *arena_realoca(Arena *a, void *p, size_t antigo, size_t novo) {
+    if (!p) return arena_aloca(a, novo);
+    if (novo <= antigo) return p;
+
+    BlocoArena *b = a->atual;
+    if (b && (char *)p == b->dados + b->ultimo &&
+        b->tamanho - b->ultimo >= alinha(novo)) {
+        size_t fim = b->ultimo + alinha(novo);
+        a->usado += fim - b->livre;
+        b->livre = fim;
+        return p;
+    }
+    void *q = arena_aloca(a, novo);
+    memcpy(q, p, antigo);
+    return q;
+}
+
+void arena_reseta(Arena *a) {
+    BlocoArena *b = a->atual;
+    if (!b) return;
+    while (b->anterior) {
+        BlocoArena *ant = b->anterior;
+        free(b);
+        b = ant;
+    }
+    b->livre = 0;
+    b->ultimo = 0;
+    a->atual = b;
+    a->usado = 0;
+}
+
+void arena_destroi(Arena *a) {
+    arena_reseta(a);
+    free(a->atual);
+    a->atual = NULL;
+}
@@ -0,0 +1,28 @@
+/* ------------------------------------------------------------------
+ * arena.h  –  Alocador em arena (blocos grandes liberados de uma vez)
+ * ------------------------------------------------------------------ */
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <stddef.h>
+
+typedef struct BlocoArena BlocoArena;
+
+typedef struct Arena {
+    BlocoArena *atual;       /* bloco de onde saem as alocações       */
+    size_t      tam_bloco;   /* tamanho padrão de um novo bloco       */
+    size_t      usado;       /* bytes entregues desde o último reset  */
+} Arena;
+
+/* tam_bloco == 0 usa o tamanho padrão */
+void  arena_inicia(Arena *a, size_t tam_bloco);
+void *arena_aloca(Arena *a, size_t n);
+char *arena_strdup(Arena *a, const char *s);
+/* cresce p (de 'antigo' para 'novo' bytes); estende no lugar se p foi a
+ * última alocação do bloco corrente, senão copia para um espaço novo */
+void *arena_realoca(Arena *a, void *p, size_t antigo, size_t novo);
+/* descarta todas as alocações, mantendo o primeiro bloco para reuso */
+void  arena_reseta(Arena *a);
+void  arena_destroi(Arena *a);
+
+#endif /* ARENA_H */
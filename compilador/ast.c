@@ -1,13 +1,40 @@
 #include "ast.h"
+#include "arena.h"
+#include "intern.h"
 #include <stdlib.h>
 #include <stdarg.h>
 #include <string.h>
 
+// Arena que guarda todos os nós e vetores de filhos da AST (os textos
+// em "valor" são ponteiros da tabela de internação, ver intern.h)
+static Arena ast_arena;
+static int   ast_arena_pronta = 0;
+
+static Arena *arena_ast(void) {
+    if (!ast_arena_pronta) {
+        arena_inicia(&ast_arena, 0);
+        ast_arena_pronta = 1;
+    }
+    return &ast_arena;
+}
+
+const char *const OP_TEXTO[N_OPS] = {
+    [OP_NENHUM]      = "?",
+    [OP_SOMA]        = "+",  [OP_SUB]         = "-",
+    [OP_MUL]         = "*",  [OP_DIV]         = "/",
+    [OP_MENOR]       = "<",  [OP_MAIOR]       = ">",
+    [OP_MENOR_IGUAL] = "<=", [OP_MAIOR_IGUAL] = ">=",
+    [OP_IGUAL]       = "==", [OP_DIFERENTE]   = "!=",
+    [OP_E]           = "e",  [OP_OU]          = "ou",
+    [OP_NEG]         = "-",  [OP_NAO]         = "!",
+};
+
 // Cria nó sem filhos
 AST *ast_cria(ASTTipo tipo, const char *valor, int linha) {
-    AST *a = (AST *)malloc(sizeof(AST));
+    AST *a = arena_aloca(arena_ast(), sizeof(AST));
     a->tipo = tipo;
-    a->valor = valor ? strdup(valor) : NULL;
+    a->op = OP_NENHUM;
+    a->valor = valor;
     a->linha = linha;
     a->n_filhos = 0;
     a->filhos = NULL;
@@ -18,7 +45,9 @@ AST *ast_cria(ASTTipo tipo, const char *valor, int linha) {
 AST *ast_cria_com_filhos(ASTTipo tipo, const char *valor, int linha, int n, ...) {
     AST *a = ast_cria(tipo, valor, linha);
     if(n > 0) {
-        a->filhos = (AST **)malloc(n * sizeof(AST *));
+        int cap = 1;
+        while (cap < n) cap *= 2;
+        a->filhos = arena_aloca(arena_ast(), cap * sizeof(AST *));
         a->n_filhos = n;
         va_list ap;
         va_start(ap, n);
@@ -29,29 +58,310 @@ AST *ast_cria_com_filhos(ASTTipo tipo, const char *valor, int linha, int n, ...)
     return a;
 }
 
-// Adiciona filho (realoca o vetor de filhos)
+// Cria nó de operador; unário quando dir == NULL
+AST *ast_cria_op(OpCode op, int linha, AST *esq, AST *dir) {
+    AST *a = dir ? ast_cria_com_filhos(AST_OP, NULL, linha, 2, esq, dir)
+                 : ast_cria_com_filhos(AST_OP, NULL, linha, 1, esq);
+    a->op = op;
+    return a;
+}
+
+// Adiciona filho. A capacidade do vetor é implícita (a menor potência
+// de 2 >= n_filhos), então ele só cresce, dobrando, quando n_filhos é
+// uma potência de 2; o vetor antigo fica na arena até o reset.
 void ast_adiciona_filho(AST *pai, AST *filho) {
-    pai->filhos = (AST **)realloc(pai->filhos, (pai->n_filhos + 1) * sizeof(AST *));
+    int n = pai->n_filhos;
+    if ((n & (n - 1)) == 0) {
+        int cap = n ? 2 * n : 1;
+        pai->filhos = arena_realoca(arena_ast(), pai->filhos,
+                                    n * sizeof(AST *), cap * sizeof(AST *));
+    }
     pai->filhos[pai->n_filhos++] = filho;
 }
 
-// Libera recursivamente
+/* ------------------------------------------------------------------
+ * Construtor de listas
+ * ------------------------------------------------------------------ */
+static ListaAST *listas_livres = NULL;
+
+static void sem_memoria(void) {
+    fprintf(stderr, "ERRO: memória insuficiente nas listas da AST.\n");
+    exit(1);
+}
+
+ListaAST *lista_nova(int linha) {
+    ListaAST *l = listas_livres;
+    if (l) {
+        listas_livres = l->prox;
+    } else {
+        l = malloc(sizeof *l);
+        if (!l) sem_memoria();
+        l->itens = NULL;
+        l->cap = 0;
+    }
+    l->n = 0;
+    l->linha = linha;
+    l->prox = NULL;
+    return l;
+}
+
+void lista_adiciona(ListaAST *l, AST *no) {
+    if (l->n == l->cap) {
+        l->cap = l->cap ? 2 * l->cap : 4;
+        l->itens = realloc(l->itens, l->cap * sizeof *l->itens);
+        if (!l->itens) sem_memoria();
+    }
+    l->itens[l->n++] = no;
+}
+
+// Cria o nó da lista com os itens acumulados (vetor exato, sem folga)
+AST *lista_finaliza(ListaAST *l, ASTTipo tipo) {
+    AST *a = ast_cria(tipo, NULL, l->linha);
+    if (l->n > 0) {
+        a->filhos = arena_aloca(arena_ast(), l->n * sizeof(AST *));
+        memcpy(a->filhos, l->itens, l->n * sizeof(AST *));
+        a->n_filhos = l->n;
+    }
+    lista_descarta(l);
+    return a;
+}
+
+void lista_descarta(ListaAST *l) {
+    l->prox = listas_livres;
+    listas_livres = l;
+}
+
+static void listas_libera(void) {
+    while (listas_livres) {
+        ListaAST *l = listas_livres;
+        listas_livres = l->prox;
+        free(l->itens);
+        free(l);
+    }
+}
+
+// Libera a AST inteira de uma vez: todos os nós vivem na mesma arena
 void ast_libera(AST *a) {
-    if(!a) return;
-    for(int i=0; i<a->n_filhos; i++)
-        ast_libera(a->filhos[i]);
+    (void)a;
+    if (ast_arena_pronta)
+        arena_reseta(&ast_arena);
+    listas_libera();
+}
+
+size_t ast_bytes(void) {
+    return ast_arena_pronta ? ast_arena.usado : 0;
+}
+
+/* ------------------------------------------------------------------
+ * AST compacta
+ * ------------------------------------------------------------------ */
+static void *cresce(void *p, uint32_t *cap, size_t tam, uint32_t minimo) {
+    if (*cap >= minimo) return p;
+    uint32_t nova = *cap ? *cap : 1024;
+    while (nova < minimo) nova *= 2;
+    p = realloc(p, (size_t)nova * tam);
+    if (!p) {
+        fprintf(stderr, "ERRO: memória insuficiente na AST compacta.\n");
+        exit(1);
+    }
+    *cap = nova;
+    return p;
+}
+
+// Literais guardam o próprio valor e ligam *literal, já que qualquer
+// valor de 32 bits é válido; o resto guarda o id internado. Nós de tipo
+// (AST_INT "int" / AST_CAR "car") ficam sem valor. O parser já recusou
+// literais inteiros acima de INT32_MAX.
+static uint32_t valor_compacto(const AST *a, int *literal) {
+    *literal = 0;
+    if (!a->valor) return SEM_VALOR;
+    if (a->tipo == AST_INT) {
+        if (a->valor[0] < '0' || a->valor[0] > '9') return SEM_VALOR;
+        *literal = 1;
+        return (uint32_t)strtoul(a->valor, NULL, 10);
+    }
+    if (a->tipo == AST_CAR) {
+        if (a->valor[0] != '\'') return SEM_VALOR;
+        *literal = 1;
+        return (unsigned char)a->valor[1];
+    }
+    return (uint32_t)intern_id(a->valor);
+}
+
+ASTC *ast_compacta(AST *raiz) {
+    ASTC *c = calloc(1, sizeof *c);
+    if (!c || !raiz) return c;
+
+    uint32_t cap_nos = 0, cap_filhos = 0, cap_base = 0, cap_longas = 0;
+    uint32_t cap_pilha = 0, n_pilha = 0;
+    /* pilha de trabalho: nó a visitar e a posição em 'filhos' que deve
+     * receber o índice dele (NO_NULO para a raiz) */
+    struct Pendente { AST *no; uint32_t vaga; } *pilha = NULL;
+
+    pilha = cresce(pilha, &cap_pilha, sizeof *pilha, 1);
+    pilha[n_pilha++] = (struct Pendente){ raiz, NO_NULO };
+    int linha_ant = 0;
+
+    while (n_pilha) {
+        struct Pendente p = pilha[--n_pilha];
+        NoId id = c->n_nos;
+        if (p.vaga != NO_NULO) c->filhos[p.vaga] = id;
+
+        c->nos = cresce(c->nos, &cap_nos, sizeof *c->nos, id + 1);
+        NoC *n = &c->nos[id];
+        AST *a = p.no;
+        n->tipo = (uint8_t)a->tipo;
+        n->op = (uint8_t)a->op;
+        int literal;
+        n->valor = valor_compacto(a, &literal);
+        n->literal = literal;
+
+        if (id % ASTC_PASSO_LINHA == 0) {
+            c->linha_base = cresce(c->linha_base, &cap_base, sizeof *c->linha_base,
+                                   id / ASTC_PASSO_LINHA + 1);
+            c->linha_base[id / ASTC_PASSO_LINHA] = a->linha;
+            n->dlinha = 0;
+        } else {
+            int d = a->linha - linha_ant;
+            if (d > INT16_MIN && d <= INT16_MAX) {
+                n->dlinha = (int16_t)d;
+            } else {
+                n->dlinha = LINHA_LONGA;
+                c->longas = cresce(c->longas, &cap_longas, sizeof *c->longas,
+                                   c->n_longas + 1);
+                c->longas[c->n_longas].no = id;
+                c->longas[c->n_longas++].linha = a->linha;
+            }
+        }
+        linha_ant = a->linha;
+        c->n_nos++;
+
+        /* reserva as vagas dos filhos e empilha do último para o
+         * primeiro, para que saiam em ordem (pré-ordem) */
+        n->filhos = c->n_filhos;
+        n->n_filhos = 0;
+        for (int i = 0; i < a->n_filhos; ++i)
+            if (a->filhos[i]) n->n_filhos++;
+        c->filhos = cresce(c->filhos, &cap_filhos, sizeof *c->filhos,
+                           c->n_filhos + n->n_filhos);
+        uint32_t vaga = c->n_filhos + n->n_filhos;
+        c->n_filhos += n->n_filhos;
+        pilha = cresce(pilha, &cap_pilha, sizeof *pilha, n_pilha + a->n_filhos);
+        for (int i = a->n_filhos - 1; i >= 0; --i)
+            if (a->filhos[i])
+                pilha[n_pilha++] = (struct Pendente){ a->filhos[i], --vaga };
+    }
+    free(pilha);
+    return c;
+}
+
+const char *astc_nome(const ASTC *a, NoId n) {
+    uint32_t v = a->nos[n].valor;
+    return v == SEM_VALOR || a->nos[n].literal ? NULL : intern_nome((int)v);
+}
+
+static int linha_longa(const ASTC *a, NoId n) {
+    uint32_t lo = 0, hi = a->n_longas;
+    while (lo < hi) {
+        uint32_t m = (lo + hi) / 2;
+        if (a->longas[m].no < n) lo = m + 1; else hi = m;
+    }
+    return a->longas[lo].linha;
+}
+
+// Soma os deltas desde a última linha de referência (no máximo
+// ASTC_PASSO_LINHA - 1 nós)
+int astc_linha(const ASTC *a, NoId n) {
+    NoId i = n - n % ASTC_PASSO_LINHA;
+    int l = a->linha_base[i / ASTC_PASSO_LINHA];
+    for (++i; i <= n; ++i) {
+        int16_t d = a->nos[i].dlinha;
+        l = (d == LINHA_LONGA) ? linha_longa(a, i) : l + d;
+    }
+    return l;
+}
+
+void astc_libera(ASTC *a) {
+    if (!a) return;
+    free(a->nos);
     free(a->filhos);
-    free(a->valor);
+    free(a->linha_base);
+    free(a->longas);
+    free(a->anot);
     free(a);
 }
 
-// Imprime AST (indentado)
-void ast_imprime(AST *a, int nivel) {
-    if(!a) return;
-    for(int i=0; i<nivel; i++) printf("  ");
-    printf("[%d] ", a->tipo);
-    if(a->valor) printf("'%s' ", a->valor);
-    printf("(linha %d)\n", a->linha);
-    for(int i=0; i<a->n_filhos; i++)
-        ast_imprime(a->filhos[i], nivel+1);
+size_t astc_bytes(const ASTC *a) {
+    return (size_t)a->n_nos * sizeof(NoC)
+         + (size_t)a->n_filhos * sizeof(NoId)
+         + ((size_t)a->n_nos + ASTC_PASSO_LINHA - 1) / ASTC_PASSO_LINHA * sizeof(int32_t)
+         + (size_t)a->n_longas * sizeof *a->longas;
+}
+
+static const char *const NOME_TIPO[] = {
+    [AST_PROGRAMA] = "PROGRAMA", [AST_FUNCAO] = "FUNCAO",
+    [AST_DECL_FUNCAO] = "DECL_FUNCAO", [AST_DECL_VARIAVEL] = "DECL_VARIAVEL",
+    [AST_LISTA_DECL_VAR] = "LISTA_DECL_VAR", [AST_LISTA_COMANDO] = "LISTA_COMANDO",
+    [AST_LISTA_PARAM] = "LISTA_PARAM", [AST_LISTA_EXPR] = "LISTA_EXPR",
+    [AST_BLOCO] = "BLOCO", [AST_COMANDO] = "COMANDO", [AST_ATRIB] = "ATRIB",
+    [AST_LEITURA] = "LEITURA", [AST_ESCRITA] = "ESCRITA", [AST_RETORNE] = "RETORNE",
+    [AST_NOVALINHA] = "NOVALINHA", [AST_SE] = "SE", [AST_SENAO] = "SENAO",
+    [AST_ENQUANTO] = "ENQUANTO", [AST_OP] = "OP", [AST_ID] = "ID",
+    [AST_INT] = "INT", [AST_CAR] = "CAR", [AST_STRING] = "STRING",
+    [AST_CHAMADA_FUNCAO] = "CHAMADA", [AST_PARAM] = "PARAM",
+};
+
+// Despeja a AST, um nó por linha, prefixado pela profundidade:
+//     NIVEL TIPO [operador|valor] [@linha]
+// Literais car saem entre aspas simples, como no fonte. O nível vai como
+// número, e não como indentação, para a saída crescer linearmente com o
+// número de nós mesmo em aninhamentos profundos. A linha só aparece
+// quando muda em relação ao nó anterior. Em pré-ordem, a profundidade de
+// cada nó sai de uma pilha com quantos filhos ainda faltam em cada nível.
+void astc_despeja(const ASTC *a, BufferSaida *b) {
+    if (!a || !a->n_nos) return;
+    uint32_t *faltam = malloc(a->n_nos * sizeof *faltam);
+    if (!faltam) {
+        fprintf(stderr, "ERRO: memória insuficiente no despejo da AST.\n");
+        exit(1);
+    }
+    int nivel = 0, linha = 0, escrita = 0;
+    for (NoId n = 0; n < a->n_nos; ++n) {
+        int16_t d = a->nos[n].dlinha;
+        if (n % ASTC_PASSO_LINHA == 0) linha = a->linha_base[n / ASTC_PASSO_LINHA];
+        else linha = (d == LINHA_LONGA) ? linha_longa(a, n) : linha + d;
+
+        bs_int(b, nivel);
+        bs_char(b, ' ');
+        bs_str(b, NOME_TIPO[NO_TIPO(a, n)]);
+        if (NO_TIPO(a, n) == AST_OP) {
+            bs_char(b, ' ');
+            bs_str(b, OP_TEXTO[NO_OP(a, n)]);
+        }
+        if (NO_E_LITERAL(a, n) && NO_TIPO(a, n) == AST_CAR) {
+            bs_bytes(b, " '", 2);
+            bs_char(b, (char)NO_LITERAL(a, n));
+            bs_char(b, '\'');
+        } else if (NO_E_LITERAL(a, n)) {
+            bs_char(b, ' ');
+            bs_int(b, NO_LITERAL(a, n));
+        } else if (a->nos[n].valor != SEM_VALOR) {
+            bs_char(b, ' ');
+            const char *nome = astc_nome(a, n);
+            bs_bytes(b, nome, intern_tamanho(nome));
+        }
+        if (n == 0 || linha != escrita) {
+            bs_bytes(b, " @", 2);
+            bs_int(b, linha);
+            escrita = linha;
+        }
+        bs_char(b, '\n');
+
+        if (NO_NFILHOS(a, n)) {
+            faltam[nivel++] = a->nos[n].n_filhos;
+        } else {
+            while (nivel > 0 && --faltam[nivel - 1] == 0) --nivel;
+        }
+    }
+    free(faltam);
 }
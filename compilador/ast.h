@@ -2,6 +2,9 @@
 #define AST_H
 
 #include <stdio.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "buffer_saida.h"
 
 /* ------------------------------------------------------------------
  * Tipos de nó da Árvore Sintática Abstrata (AST)
@@ -43,12 +46,35 @@ typedef enum {
     /* Use este espaço para extensões futuras */
 } ASTTipo;
 
+/* ------------------------------------------------------------------
+ * Operadores (campo 'op' dos nós AST_OP)
+ * ------------------------------------------------------------------ */
+typedef enum {
+    OP_NENHUM,               /* nó que não é AST_OP                   */
+
+    /* aritméticos: int x int -> int */
+    OP_SOMA, OP_SUB, OP_MUL, OP_DIV,
+    /* relacionais: mesmo tipo -> int */
+    OP_MENOR, OP_MAIOR, OP_MENOR_IGUAL, OP_MAIOR_IGUAL,
+    OP_IGUAL, OP_DIFERENTE,
+    /* lógicos: int x int -> int */
+    OP_E, OP_OU,
+    /* unários: int -> int */
+    OP_NEG, OP_NAO,
+
+    N_OPS
+} OpCode;
+
+/* grafia de cada operador no fonte (mensagens e impressão da AST) */
+extern const char *const OP_TEXTO[N_OPS];
+
 /* ------------------------------------------------------------------
  * Estrutura do nó
  * ------------------------------------------------------------------ */
 typedef struct AST {
     ASTTipo       tipo;
-    char         *valor;     /* nome de id, operador, literal, etc.   */
+    OpCode        op;        /* operador, se tipo == AST_OP           */
+    const char   *valor;     /* id, literal (internado)               */
     int           linha;     /* linha de origem no fonte              */
     int           n_filhos;  /* número de filhos                      */
     struct AST  **filhos;    /* vetor de ponteiros p/ filhos          */
@@ -57,12 +83,112 @@ typedef struct AST {
 /* ------------------------------------------------------------------
  * API básica de manipulação da AST
  * ------------------------------------------------------------------ */
+/* 'valor' deve vir de intern()/intern_str(): o nó guarda o ponteiro */
 AST *ast_cria(ASTTipo tipo, const char *valor, int linha);
 /* cria nó já com n filhos (varargs: n ponteiros AST*) */
 AST *ast_cria_com_filhos(ASTTipo tipo, const char *valor,
                          int linha, int n, ...);
+/* nó AST_OP binário (dir != NULL) ou unário (dir == NULL) */
+AST *ast_cria_op(OpCode op, int linha, AST *esq, AST *dir);
 void ast_adiciona_filho(AST *pai, AST *filho);
-void ast_libera(AST *a);
-void ast_imprime(AST *a, int nivel);
+void ast_libera(AST *a);        /* também libera os construtores de lista */
+size_t ast_bytes(void);        /* bytes ocupados hoje na arena da AST */
+
+/* ------------------------------------------------------------------
+ * Construtor de listas para as ações do parser
+ *
+ * Os itens são acumulados num vetor de rascunho que dobra de tamanho
+ * (fora da arena) e, quando a lista termina, lista_finaliza() cria o
+ * nó com o vetor de filhos de tamanho exato. O nó devolvido não deve
+ * receber ast_adiciona_filho. Construtores finalizados ou descartados
+ * são reaproveitados, junto com o rascunho, pela próxima lista.
+ * ------------------------------------------------------------------ */
+typedef struct ListaAST {
+    AST            **itens;
+    int              n, cap;
+    int              linha;     /* linha do nó que será criado      */
+    struct ListaAST *prox;      /* encadeamento dos livres          */
+} ListaAST;
+
+ListaAST *lista_nova(int linha);
+void      lista_adiciona(ListaAST *l, AST *no);
+AST      *lista_finaliza(ListaAST *l, ASTTipo tipo);
+void      lista_descarta(ListaAST *l);
+
+/* ------------------------------------------------------------------
+ * AST compacta
+ *
+ * Depois do parse a árvore de ponteiros é achatada num vetor contíguo
+ * de nós em pré-ordem (a raiz é o nó 0 e o primeiro filho de n, se
+ * existir, é n+1). Os filhos de cada nó são índices de 32 bits,
+ * guardados lado a lado em 'filhos'. Nomes são ids internados e a
+ * linha é a diferença para o nó anterior; a cada ASTC_PASSO_LINHA nós
+ * há uma linha absoluta de referência.
+ * ------------------------------------------------------------------ */
+typedef uint32_t NoId;
+#define NO_NULO    UINT32_MAX
+#define SEM_VALOR  UINT32_MAX           /* campo 'valor' vazio            */
+#define LINHA_LONGA INT16_MIN           /* delta não cabe em 16 bits      */
+#define ASTC_PASSO_LINHA 64
+
+typedef struct NoC {
+    uint8_t  tipo;       /* ASTTipo                                      */
+    uint8_t  op : 7;     /* OpCode (AST_OP)                              */
+    uint8_t  literal : 1;/* AST_INT/AST_CAR com valor (não nó de tipo)   */
+    int16_t  dlinha;     /* linha - linha do nó anterior                 */
+    uint32_t valor;      /* id internado, ou o valor de AST_INT/AST_CAR  */
+    uint32_t filhos;     /* posição do 1º filho em ASTC.filhos           */
+    uint32_t n_filhos;
+} NoC;
+
+/* ------------------------------------------------------------------
+ * Anotações da análise semântica
+ *
+ * semantico.c resolve cada nome uma única vez e grava o resultado em
+ * ASTC.anot (um registro por nó); a geração de código lê o endereço e
+ * o tipo dali, sem consultar a tabela de símbolos.
+ * ------------------------------------------------------------------ */
+typedef enum {
+    LUGAR_NENHUM,            /* nó não se refere a um nome            */
+    LUGAR_GLOBAL,            /* global: 'slot' é o nó da declaração   */
+    LUGAR_FRAME,             /* parâmetro/local: em slot($fp)         */
+    LUGAR_FUNCAO,            /* chamada: 'slot' é o nó AST_DECL_FUNCAO */
+} Lugar;
+
+typedef struct Anot {
+    uint8_t  tipo;           /* Tipo (tabela_simbolos.h) do valor     */
+    uint8_t  lugar;          /* Lugar                                 */
+    int32_t  slot;           /* ver Lugar; em AST_DECL_FUNCAO é o
+                                tamanho do frame em bytes             */
+} Anot;
+
+typedef struct ASTC {
+    NoC      *nos;
+    uint32_t  n_nos;
+    NoId     *filhos;
+    uint32_t  n_filhos;
+    int32_t  *linha_base;    /* linha absoluta dos nós k*ASTC_PASSO_LINHA */
+    struct { NoId no; int32_t linha; } *longas;  /* deltas fora de 16 bits */
+    uint32_t  n_longas;
+    Anot     *anot;          /* NULL até a análise semântica          */
+} ASTC;
+
+/* Acesso aos campos; 'a' é const ASTC * */
+#define NO_TIPO(a, n)      ((ASTTipo)(a)->nos[n].tipo)
+#define NO_OP(a, n)        ((OpCode)(a)->nos[n].op)
+#define NO_NFILHOS(a, n)   ((int)(a)->nos[n].n_filhos)
+#define NO_FILHO(a, n, k)  ((a)->filhos[(a)->nos[n].filhos + (k)])
+#define NO_LITERAL(a, n)   ((int32_t)(a)->nos[n].valor)
+#define NO_E_LITERAL(a, n) ((a)->nos[n].literal)
+#define NO_ANOT(a, n)      ((a)->anot[n])
+const char *astc_nome(const ASTC *a, NoId n);    /* NULL se sem valor */
+int         astc_linha(const ASTC *a, NoId n);
+
+/* Achata a árvore (que pode então ser liberada com ast_libera) */
+ASTC  *ast_compacta(AST *raiz);
+void   astc_libera(ASTC *a);
+size_t astc_bytes(const ASTC *a);
+/* Um nó por linha, indentado por nível (ver ast.c) */
+void   astc_despeja(const ASTC *a, BufferSaida *b);
 
 #endif /* AST_H */
@@ -0,0 +1,167 @@
+/* ------------------------------------------------------------------
+ * gera_programa.c  –  Gera programas Goianinha sintéticos (válidos)
+ *                     de tamanho escalável, para medir o compilador
+ *
+ * Uso: gera_programa [-f FUNCOES] [-g GLOBAIS] [-n ANINHAMENTO]
+ *                    [-e TERMOS] [-s STRINGS] [ESCALA]
+ *        gera_programa -x PROFUNDIDADE
+ *
+ * ESCALA (padrão 1) multiplica as quantidades de funções, globais e
+ * strings; o aninhamento de blocos e o tamanho das expressões ficam
+ * fixos, a não ser que sejam dados explicitamente.
+ *
+ * -x gera um programa de estresse: comandos se/enquanto/blocos
+ * aninhados PROFUNDIDADE vezes, uma soma com PROFUNDIDADE termos e
+ * uma expressão com PROFUNDIDADE níveis de parênteses e '-' unário.
+ * ------------------------------------------------------------------ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static int n_funcoes = 50;     /* por unidade de escala            */
+static int n_globais = 200;    /* por unidade de escala            */
+static int n_strings = 100;    /* por unidade de escala            */
+static int aninhamento = 8;    /* blocos { } dentro de cada função */
+static int termos = 16;        /* operandos por expressão longa    */
+
+static void recua(int n) {
+    for (int i = 0; i < n; ++i) fputs("    ", stdout);
+}
+
+/* expressão com 'termos' operandos misturando globais, parâmetros e
+ * literais; só + - * para não arriscar divisão por zero */
+static void expressao(int semente, int profundidade) {
+    static const char *const ops[] = { " + ", " - ", " * " };
+    for (int t = 0; t < termos; ++t) {
+        if (t) fputs(ops[(semente + t) % 3], stdout);
+        switch ((semente * 7 + t) % 4) {
+        case 0: printf("g%d", (semente + t) % n_globais); break;
+        case 1: fputs(t % 2 ? "a" : "b", stdout); break;
+        case 2: printf("%d", (semente + t) % 97); break;
+        case 3: printf("x%d", (semente + t) % (profundidade + 1)); break;
+        }
+    }
+}
+
+static void funcao(int f, int *prox_string, int strings_por_funcao) {
+    printf("int f%d(int a, int b) {\n", f);
+    puts("    int x0;");
+    puts("    x0 = a;");
+
+    /* blocos aninhados, cada um com um local novo x<nível> */
+    for (int d = 1; d <= aninhamento; ++d) {
+        recua(d);
+        printf("{\n");
+        recua(d + 1);
+        printf("int x%d;\n", d);
+        recua(d + 1);
+        printf("x%d = ", d);
+        expressao(f + d, d - 1);
+        printf(";\n");
+    }
+    recua(aninhamento + 1);
+    printf("x0 = x%d;\n", aninhamento);
+    for (int d = aninhamento; d >= 1; --d) {
+        recua(d);
+        printf("}\n");
+    }
+
+    for (int s = 0; s < strings_por_funcao; ++s) {
+        printf("    se (x0 > %d) entao escreva \"mensagem %d da funcao %d\";\n",
+               s, (*prox_string)++, f);
+    }
+    puts("    enquanto (x0 > 100) execute x0 = x0 - 7;");
+    if (f > 0)
+        printf("    se (a < b) entao x0 = x0 + f%d(b, a);\n", f - 1);
+    printf("    retorne x0 + ");
+    expressao(f, 0);
+    printf(";\n}\n\n");
+}
+
+/* sem indentação, para o arquivo crescer linearmente */
+static void estresse(int n) {
+    static const char *const abre[] = {
+        "se (x == 0) entao {\n", "enquanto (x < 0) execute {\n", "{\n",
+    };
+    printf("/* gerado por gera_programa -x %d */\n\n", n);
+    puts("programa {");
+    puts("int x;");
+    puts("x = 0;");
+    for (int i = 0; i < n; ++i) fputs(abre[i % 3], stdout);
+    puts("x = x + 1;");
+    for (int i = 0; i < n; ++i) fputs("}\n", stdout);
+
+    fputs("x = x", stdout);
+    for (int i = 0; i < n; ++i) fputs(i % 64 ? " + 1" : "\n + 1", stdout);
+    puts(";");
+
+    fputs("x = ", stdout);
+    for (int i = 0; i < n; ++i) fputs(i % 64 ? "-(" : "\n-(", stdout);
+    fputs("x", stdout);
+    for (int i = 0; i < n; ++i) fputs(i % 64 ? ")" : ")\n", stdout);
+    puts(";");
+
+    puts("escreva x;");
+    puts("novalinha;");
+    puts("}");
+}
+
+int main(int argc, char **argv) {
+    int escala = 1;
+    int fixa_f = -1, fixa_g = -1, fixa_s = -1;
+    for (int i = 1; i < argc; ++i) {
+        if (i + 1 < argc && strcmp(argv[i], "-f") == 0) fixa_f = atoi(argv[++i]);
+        else if (i + 1 < argc && strcmp(argv[i], "-g") == 0) fixa_g = atoi(argv[++i]);
+        else if (i + 1 < argc && strcmp(argv[i], "-s") == 0) fixa_s = atoi(argv[++i]);
+        else if (i + 1 < argc && strcmp(argv[i], "-n") == 0) aninhamento = atoi(argv[++i]);
+        else if (i + 1 < argc && strcmp(argv[i], "-e") == 0) termos = atoi(argv[++i]);
+        else if (i + 1 < argc && strcmp(argv[i], "-x") == 0) {
+            estresse(atoi(argv[++i]));
+            return 0;
+        }
+        else if (argv[i][0] != '-') escala = atoi(argv[i]);
+        else {
+            fprintf(stderr, "Uso: %s [-f FUNCOES] [-g GLOBAIS] [-n ANINHAMENTO] "
+                            "[-e TERMOS] [-s STRINGS] [ESCALA]\n"
+                            "     %s -x PROFUNDIDADE\n", argv[0], argv[0]);
+            return 1;
+        }
+    }
+    if (escala < 1) escala = 1;
+    n_funcoes = fixa_f >= 0 ? fixa_f : n_funcoes * escala;
+    n_globais = fixa_g >= 0 ? fixa_g : n_globais * escala;
+    n_strings = fixa_s >= 0 ? fixa_s : n_strings * escala;
+    if (n_globais < 1) n_globais = 1;
+    if (aninhamento < 0) aninhamento = 0;
+    if (termos < 1) termos = 1;
+
+    printf("/* gerado por gera_programa: %d funções, %d globais, "
+           "%d strings, aninhamento %d, %d termos */\n\n",
+           n_funcoes, n_globais, n_strings, aninhamento, termos);
+
+    /* globais, dez por declaração */
+    for (int g = 0; g < n_globais; g += 10) {
+        printf("int g%d", g);
+        for (int k = g + 1; k < g + 10 && k < n_globais; ++k) printf(", g%d", k);
+        printf(";\n");
+    }
+    putchar('\n');
+
+    int prox_string = 0;
+    int por_funcao = n_funcoes ? (n_strings + n_funcoes - 1) / n_funcoes : 0;
+    for (int f = 0; f < n_funcoes; ++f)
+        funcao(f, &prox_string, prox_string + por_funcao <= n_strings
+                                ? por_funcao : n_strings - prox_string);
+
+    puts("programa {");
+    puts("    int r;");
+    puts("    r = 0;");
+    for (int g = 0; g < n_globais; ++g) printf("    g%d = %d;\n", g, g % 13);
+    if (n_funcoes > 0) printf("    r = f%d(1, 2);\n", n_funcoes - 1);
+    for (; prox_string < n_strings; ++prox_string)
+        printf("    escreva \"mensagem %d do programa\";\n", prox_string);
+    puts("    escreva r;");
+    puts("    novalinha;");
+    puts("}");
+    return 0;
+}
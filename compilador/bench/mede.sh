@@ -0,0 +1,62 @@
+#!/bin/sh
+# ------------------------------------------------------------------
+# mede.sh  –  Custo de compilação em programas sintéticos crescentes
+#             (chamado por make bench-compile e make estresse)
+#
+# Uso: bench/mede.sh ESCALA...          programas largos (gera_programa N)
+#      bench/mede.sh -x PROFUNDIDADE... aninhamento profundo (gera_programa -x N)
+#
+# Para cada valor gera um programa com bench/gera_programa, compila
+# três vezes com -ftime-report-json e fica com a melhor. Informa linhas/s,
+# custo por linha e pico de memória. Falha se o compilador não terminar
+# bem (p.ex. estouro da pilha C) ou se o custo por linha de algum valor
+# passar do dobro do custo no menor (crescimento não linear).
+# ------------------------------------------------------------------
+GOIANINHA=./goianinha
+GERADOR=bench/gera_programa
+TMP=${TMPDIR:-/tmp}/mede_goianinha.$$
+mkdir -p "$TMP" || exit 1
+trap 'rm -rf "$TMP"' EXIT
+
+opcao=""
+rotulo=escala
+if [ "$1" = "-x" ]; then
+    opcao=-x
+    rotulo=profundidade
+    shift
+fi
+[ $# -gt 0 ] || { echo "Uso: $0 [-x] VALOR..."; exit 2; }
+
+printf "%12s %9s %11s %12s %10s %10s\n" $rotulo linhas "tempo(ms)" "linhas/s" "us/linha" "RSS(KiB)"
+base=""
+falhou=0
+for v in "$@"; do
+    "$GERADOR" $opcao "$v" > "$TMP/p.txt" || exit 1
+    melhor=""
+    for rep in 1 2 3; do
+        if ! "$GOIANINHA" -o /dev/null -ftime-report-json="$TMP/r.json" "$TMP/p.txt"; then
+            echo "ERRO: falha ao compilar o programa de $rotulo $v"
+            exit 1
+        fi
+        # total: {"parede_ms": T, ..., "pico_rss_kib": R}
+        t=$(sed -n 's/.*"total": {"parede_ms": \([0-9.]*\).*/\1/p' "$TMP/r.json")
+        t=$(awk "BEGIN{print ($t > 0.001 ? $t : 0.001)}")
+        rss=$(sed -n 's/.*"total": {.*"pico_rss_kib": \([0-9]*\).*/\1/p' "$TMP/r.json")
+        if [ -z "$melhor" ] || awk "BEGIN{exit !($t < $melhor)}"; then
+            melhor=$t
+            melhor_rss=$rss
+        fi
+    done
+    linhas=$(sed -n 's/.*"linhas": \([0-9]*\).*/\1/p' "$TMP/r.json")
+    us=$(awk "BEGIN{printf \"%.3f\", $melhor * 1000 / $linhas}")
+    [ -n "$base" ] || base=$us
+    aviso=""
+    if awk "BEGIN{exit !($us > 2 * $base)}"; then
+        aviso="  <-- não linear ($(awk "BEGIN{printf \"%.1f\", $us / $base}")x o custo por linha do menor valor)"
+        falhou=1
+    fi
+    printf "%12s %9s %11.1f %12.0f %10s %10s%s\n" "$v" "$linhas" "$melhor" \
+        "$(awk "BEGIN{print $linhas * 1000 / $melhor}")" "$us" "$melhor_rss" "$aviso"
+done
+[ $falhou = 0 ] || { echo "ATENÇÃO: crescimento não linear detectado"; exit 1; }
+exit 0
@@ -0,0 +1,120 @@
+#include "buffer_saida.h"
+#include "estatisticas.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#define BS_CAP_INICIAL (64 * 1024)
+#define BS_LIMITE      (256 * 1024)
+
+static void inicia(BufferSaida *b, int fd, size_t limite) {
+    b->dados = NULL;
+    b->tam = b->cap = 0;
+    b->fd = fd;
+    b->fecha_fd = 0;
+    b->limite = limite;
+    b->escritos = 0;
+    b->erro = 0;
+}
+
+void bs_abre_fd(BufferSaida *b, int fd) {
+    inicia(b, fd, BS_LIMITE);
+}
+
+int bs_abre_arquivo(BufferSaida *b, const char *caminho) {
+    int fd = open(caminho, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        perror(caminho);
+        return 0;
+    }
+    inicia(b, fd, BS_LIMITE);
+    b->fecha_fd = 1;
+    return 1;
+}
+
+void bs_abre_memoria(BufferSaida *b) {
+    inicia(b, -1, 0);
+}
+
+static void garante(BufferSaida *b, size_t n) {
+    if (b->tam + n <= b->cap) return;
+    size_t cap = b->cap ? b->cap : BS_CAP_INICIAL;
+    while (cap < b->tam + n) cap *= 2;
+    b->dados = realloc(b->dados, cap);
+    if (!b->dados) {
+        fprintf(stderr, "ERRO: memória insuficiente no buffer de saída.\n");
+        exit(1);
+    }
+    b->cap = cap;
+}
+
+static void talvez_despeja(BufferSaida *b) {
+    if (b->limite && b->tam >= b->limite) bs_despeja(b);
+}
+
+void bs_bytes(BufferSaida *b, const char *s, size_t n) {
+    garante(b, n);
+    memcpy(b->dados + b->tam, s, n);
+    b->tam += n;
+    talvez_despeja(b);
+}
+
+void bs_str(BufferSaida *b, const char *s) {
+    bs_bytes(b, s, strlen(s));
+}
+
+void bs_char(BufferSaida *b, char c) {
+    garante(b, 1);
+    b->dados[b->tam++] = c;
+    talvez_despeja(b);
+}
+
+void bs_int(BufferSaida *b, long v) {
+    char tmp[24];
+    int i = sizeof tmp;
+    unsigned long u = v < 0 ? 0UL - (unsigned long)v : (unsigned long)v;
+    do {
+        tmp[--i] = (char)('0' + u % 10);
+        u /= 10;
+    } while (u);
+    if (v < 0) tmp[--i] = '-';
+    bs_bytes(b, tmp + i, sizeof tmp - i);
+}
+
+int bs_despeja(BufferSaida *b) {
+    if (b->fd < 0) return !b->erro;
+    est_entra(FASE_SAIDA);
+    size_t feito = 0;
+    while (feito < b->tam) {
+        ssize_t r = write(b->fd, b->dados + feito, b->tam - feito);
+        if (r < 0) {
+            if (errno == EINTR) continue;
+            b->erro = 1;
+            break;
+        }
+        feito += (size_t)r;
+    }
+    b->escritos += feito;
+    b->tam = 0;
+    est_conta(FASE_SAIDA, (long)feito);
+    est_sai(FASE_SAIDA);
+    return !b->erro;
+}
+
+int bs_fecha(BufferSaida *b) {
+    if (b->fd < 0) return !b->erro;
+    bs_despeja(b);
+    if (b->fecha_fd && close(b->fd) < 0) b->erro = 1;
+    b->fd = -1;
+    bs_libera(b);
+    return !b->erro;
+}
+
+void bs_libera(BufferSaida *b) {
+    free(b->dados);
+    b->dados = NULL;
+    b->tam = b->cap = 0;
+}
@@ -0,0 +1,40 @@
+/* ------------------------------------------------------------------
+ * buffer_saida.h  –  Buffer de bytes crescente para a saída do
+ *                    compilador, sem printf: inteiros e textos são
+ *                    copiados à mão e o conteúdo sai com write(2)
+ * ------------------------------------------------------------------ */
+#ifndef BUFFER_SAIDA_H
+#define BUFFER_SAIDA_H
+
+#include <stddef.h>
+
+typedef struct BufferSaida {
+    char   *dados;
+    size_t  tam;         /* bytes pendentes em dados[]                */
+    size_t  cap;
+    int     fd;          /* destino; -1 = só memória                  */
+    int     fecha_fd;    /* 1 se o fd foi aberto por bs_abre_arquivo  */
+    size_t  limite;      /* despeja ao passar disto (0 = só no fim)   */
+    size_t  escritos;    /* total já enviado ao fd                    */
+    int     erro;        /* 1 se alguma escrita falhou                */
+} BufferSaida;
+
+/* Destinos: descritor já aberto (ex.: 1 para stdout), arquivo criado
+ * ou truncado, ou memória (o conteúdo fica em dados[0..tam-1]). */
+void bs_abre_fd(BufferSaida *b, int fd);
+int  bs_abre_arquivo(BufferSaida *b, const char *caminho);
+void bs_abre_memoria(BufferSaida *b);
+
+void bs_bytes(BufferSaida *b, const char *s, size_t n);
+void bs_str(BufferSaida *b, const char *s);
+void bs_char(BufferSaida *b, char c);
+void bs_int(BufferSaida *b, long v);
+
+/* Envia o que está pendente ao fd (nada em modo memória). */
+int  bs_despeja(BufferSaida *b);
+/* Despeja, fecha o fd se for nosso e libera a memória; retorna 0 se
+ * houve erro de escrita. Em modo memória não libera: use bs_libera. */
+int  bs_fecha(BufferSaida *b);
+void bs_libera(BufferSaida *b);
+
+#endif /* BUFFER_SAIDA_H */
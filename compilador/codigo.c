@@ -4,104 +4,659 @@
  * ===================================================================== */
 #include "codigo.h"
 #include "tabela_simbolos.h"
+#include "intern.h"
+#include "estatisticas.h"
+#include "ir.h"
+#include "passes.h"
+#include "emissor.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
-#include <stdarg.h>
-#include <limits.h> // Para INT_MAX
 
 // --- ESTRUTURAS PARA GERENCIAMENTO MULTI-PASSADA ---
 
 // Para a lista de strings literais encontradas na primeira passada
 typedef struct StringLiteral {
-    char* valor;
-    char label[32];
+    const char* valor;       // ponteiro internado
+    int id;                  // rótulo "str<id>"
     struct StringLiteral* next;
 } StringLiteral;
 
 static StringLiteral* lista_strings = NULL;
 static int string_id_counter = 0;
+static uint8_t *string_usada = NULL;    // por id: algum 'la' sobrou
+static long n_strings_omitidas;         // -ftime-report
 
 // --- PROTÓTIPOS INTERNOS ---
 
-static void gera_funcao(AST *decl);
-static const char *gera_expr(AST *e);
-static void gera_comando(AST *c, const char *rotulo_saida_func);
-static void coleta_strings_pass(AST *no);
+static void gera_funcao(NoId decl);
+static void gera_comando(NoId c);
+static void coleta_strings_pass(void);
+
+/* AST compacta em geração e atalhos de acesso aos nós */
+static const ASTC *arv;
+
+#define TIPO(n)      NO_TIPO(arv, n)
+#define NFILHOS(n)   NO_NFILHOS(arv, n)
+#define FILHO(n, k)  NO_FILHO(arv, n, k)
+#define NOME(n)      astc_nome(arv, n)
+#define ANOT(n)      NO_ANOT(arv, n)
+#define LITERAL(n)   (TIPO(n) == AST_INT || TIPO(n) == AST_CAR)
+
+/* ------------------------------------------------------------------ */
+/* Registradores                                                      */
+/* ------------------------------------------------------------------ */
+// Registradores são representados pelo número MIPS; o texto vem da
+// tabela do emissor
+enum {
+    R_ZERO = 0, R_V0 = 2, R_V1 = 3, R_A0 = 4,
+    R_T0 = 8, R_S0 = 16, R_T8 = 24, R_SP = 29, R_FP = 30, R_RA = 31
+};
 
 /* ------------------------------------------------------------------ */
 /* Emissão e Rótulos                                                  */
 /* ------------------------------------------------------------------ */
-static FILE *out;
+// As instruções de cada função vão para a representação intermediária
+// (ir.h); os passes trabalham sobre ela e emissor.c escreve o texto.
+static BufferSaida *out;
+static FuncaoIR fn;                 // função em geração
+static long n_instrucoes;           // para -ftime-report
+static long n_acessos_memoria;      // lw/sw emitidos
 static int rotulo_id = 0;
+static const char *nome_programa;   // intern_str("programa")
 
-static void emit(const char *fmt, ...) __attribute__((format(printf, 1, 2)));
-static void emit(const char *fmt, ...) {
-    va_list ap;
-    va_start(ap, fmt);
-    vfprintf(out, fmt, ap);
-    va_end(ap);
+static void emit_rrr(Mnemonico op, int a, int b, int c) {
+    ir_instr(&fn, op, 3, ir_reg(a), ir_reg(b), ir_reg(c));
+}
+static void emit_rr(Mnemonico op, int a, int b) {
+    ir_instr(&fn, op, 2, ir_reg(a), ir_reg(b), ir_nada());
+}
+static void emit_r(Mnemonico op, int a) {
+    ir_instr(&fn, op, 1, ir_reg(a), ir_nada(), ir_nada());
+}
+static void emit_ri(Mnemonico op, int a, long imm) {
+    ir_instr(&fn, op, 2, ir_reg(a), ir_imed(imm), ir_nada());
+}
+static void emit_rri(Mnemonico op, int a, int b, long imm) {
+    ir_instr(&fn, op, 3, ir_reg(a), ir_reg(b), ir_imed(imm));
+}
+static void emit_mem(Mnemonico op, int r, int off, int base) {
+    ++n_acessos_memoria;
+    ir_instr(&fn, op, 2, ir_reg(r), ir_mem(off, base), ir_nada());
+}
+static void emit_mem_var(Mnemonico op, int r, const char *nome) {
+    ++n_acessos_memoria;
+    ir_instr(&fn, op, 2, ir_reg(r), ir_var(nome), ir_nada());
+}
+static void emit_desvio(Mnemonico op, int a, int b, int rotulo) {
+    ir_instr(&fn, op, 3, ir_reg(a), ir_reg(b), ir_rotulo(rotulo));
+}
+static void emit_desvio_imediato(Mnemonico op, int a, long imm, int rotulo) {
+    ir_instr(&fn, op, 3, ir_reg(a), ir_imed(imm), ir_rotulo(rotulo));
+}
+static void emit_desvio_zero(Mnemonico op, int a, int rotulo) {
+    ir_instr(&fn, op, 2, ir_reg(a), ir_rotulo(rotulo), ir_nada());
+}
+static void emit_j(int rotulo) {
+    ir_instr(&fn, M_J, 1, ir_rotulo(rotulo), ir_nada(), ir_nada());
+}
+static void emit_syscall(void) {
+    ir_instr(&fn, M_SYSCALL, 0, ir_nada(), ir_nada(), ir_nada());
+}
+static void emit_rotulo(int id) {
+    ir_instr(&fn, M_ROTULO, 1, ir_rotulo(id), ir_nada(), ir_nada());
 }
 
-static void novo_rotulo(char *buffer, int max_size) {
-    snprintf(buffer, max_size, "L%d", rotulo_id++);
+static int novo_rotulo(void) {
+    return rotulo_id++;
 }
 
-// Gera um nome de label seguro para funções (ex: user_minhaFunc)
-static void gera_nome_label_func(const char* nome_original, char* buffer_saida, int max_size) {
-    if (strcmp(nome_original, "programa") == 0) {
-        strncpy(buffer_saida, "main", max_size);
-    } else {
-        snprintf(buffer_saida, max_size, "user_%s", nome_original);
+
+/* ------------------------------------------------------------------ */
+/* Condições constantes                                               */
+/* ------------------------------------------------------------------ */
+// Em -O2, 'se', 'se ... senao' e 'enquanto' com condição literal (em
+// geral dobrada por otimiza.c) geram só o ramo que executa; o outro
+// nem chega à alocação de registradores.
+static int poda_ramos;              // passes_nivel_atual() >= 2
+static long n_ramos_constantes;     // -ftime-report
+static long n_funcoes_omitidas;     // -ftime-report
+
+// Valor (0 ou 1) da condição de c se ela é literal e a poda está
+// ligada; senão -1
+static int condicao_constante(NoId c) {
+    if (!poda_ramos) return -1;
+    NoId cond;
+    switch (TIPO(c)) {
+        case AST_SE: case AST_ENQUANTO: cond = FILHO(c, 0); break;
+        case AST_SENAO: cond = FILHO(FILHO(c, 0), 0); break;
+        default: return -1;
     }
+    return LITERAL(cond) ? NO_LITERAL(arv, cond) != 0 : -1;
 }
 
-// Gera um nome de label seguro para variáveis globais
-static void gera_nome_label_var(const char* nome_original, char* buffer_saida, int max_size) {
-    snprintf(buffer_saida, max_size, "var_%s", nome_original);
+// O filho k de n nunca é gerado? (o 'entao' de um 'se ... senao'
+// falso é filho do 'se' de dentro, que responde por ele)
+static int filho_morto(NoId n, int k) {
+    int v = condicao_constante(n);
+    if (v < 0 || k != 1) return 0;
+    return TIPO(n) == AST_SENAO ? v : !v;
 }
 
 
 /* ------------------------------------------------------------------ */
-/* Gerenciamento de Símbolos no Frame (Parâmetros e Locais)           */
+/* Variáveis em registradores                                         */
 /* ------------------------------------------------------------------ */
-#define MAX_FRAME_SYMBOLS 64
+// Parâmetros e locais de cada função podem morar em $s0..$s7 (alocação
+// por varredura linear). O intervalo de vida de uma variável vai da
+// primeira à última ocorrência na pré-ordem da função; os parâmetros
+// nascem na entrada. Se ela aparece dentro de um 'enquanto', o
+// intervalo cobre o laço inteiro, porque o valor pode voltar pelo
+// desvio do fim do laço. Variáveis cujos intervalos não se cruzam
+// dividem o registrador; as que sobram continuam no quadro. Os $s
+// usados são salvos no prólogo, logo acima das locais.
+// As variáveis são identificadas pela posição no quadro (semantico.c):
+// locais de blocos irmãos que dividem a posição são tratadas como uma.
 #define WORD_SIZE 4
-static struct { char nome[32]; int offset; } frame_map[MAX_FRAME_SYMBOLS];
-static int frame_map_size = 0;
+#define N_SREG 8
+
+typedef struct { int ini, fim, palavra; } Intervalo;
+
+static uint8_t *reg_var = NULL;     // por palavra do quadro: $s ou 0
+static Intervalo *intervalos = NULL;
+static size_t cap_var = 0;
+static NoId *lacos = NULL;          // pares (início, fim) dos 'enquanto'
+static size_t n_lacos = 0, cap_lacos = 0;
+static struct { NoId no; int prox; } *abertos = NULL;
+static size_t cap_abertos = 0;
+static unsigned sreg_usados;        // máscara de $s0..$s7 na função
+static long n_vars_reg, n_vars_memoria;     // -ftime-report
 
-static void frame_map_init(void) { frame_map_size = 0; }
+static void sem_memoria(void) {
+    fprintf(stderr, "ERRO: memória insuficiente na geração de código.\n");
+    exit(1);
+}
+
+static void *cresce_pilha(void *p, size_t *cap, size_t tam);
+
+#define REG_DA_VAR(id) \
+    (ANOT(id).lugar == LUGAR_FRAME ? reg_var[ANOT(id).slot / WORD_SIZE] : 0)
+
+static void usa_palavra(int w, int pos) {
+    if (pos < intervalos[w].ini) intervalos[w].ini = pos;
+    if (pos > intervalos[w].fim) intervalos[w].fim = pos;
+}
+
+static int compara_inicio(const void *a, const void *b) {
+    const Intervalo *x = a, *y = b;
+    return x->ini != y->ini ? (x->ini < y->ini ? -1 : 1) : x->palavra - y->palavra;
+}
 
-static void frame_map_add(const char *n, int off) {
-    if (frame_map_size < MAX_FRAME_SYMBOLS) {
-        strncpy(frame_map[frame_map_size].nome, n, 31);
-        frame_map[frame_map_size].nome[31] = '\0';
-        frame_map[frame_map_size].offset = off;
-        ++frame_map_size;
+static void aloca_variaveis(NoId decl, NoId listaParam) {
+    size_t n_pal = ANOT(decl).slot / WORD_SIZE;
+    if (cap_var < n_pal) {
+        cap_var = n_pal;
+        reg_var = realloc(reg_var, cap_var * sizeof *reg_var);
+        intervalos = realloc(intervalos, cap_var * sizeof *intervalos);
+        if (!reg_var || !intervalos) sem_memoria();
+    }
+    for (size_t w = 0; w < n_pal; ++w) {
+        reg_var[w] = 0;
+        intervalos[w] = (Intervalo){ INT32_MAX, -1, (int)w };
+    }
+    sreg_usados = 0;
+
+    if (listaParam != NO_NULO)
+        for (int i = 0; i < NFILHOS(listaParam); ++i)
+            usa_palavra(ANOT(FILHO(listaParam, i)).slot / WORD_SIZE, (int)decl);
+
+    // Ocorrências, em profundidade com pilha explícita (otimiza.c pode
+    // ter deixado nós fora da árvore, então não basta varrer os
+    // índices). Os nós aparecem em ordem crescente, e o fim de um laço
+    // é o último nó visto quando ele fecha; os laços saem de dentro
+    // para fora. Ramos que não serão gerados ficam de fora.
+    size_t n_abertos = 0;
+    n_lacos = 0;
+    NoId n = decl, ultimo = decl;
+    for (;;) {
+        if (TIPO(n) == AST_ID && ANOT(n).lugar == LUGAR_FRAME)
+            usa_palavra(ANOT(n).slot / WORD_SIZE, (int)n);
+        ultimo = n;
+        if (n_abertos == cap_abertos)
+            abertos = cresce_pilha(abertos, &cap_abertos, sizeof *abertos);
+        abertos[n_abertos].no = n;
+        abertos[n_abertos++].prox = 0;
+        while (n_abertos) {
+            NoId fechado = abertos[n_abertos - 1].no;
+            int *prox = &abertos[n_abertos - 1].prox;
+            while (*prox < NFILHOS(fechado) && filho_morto(fechado, *prox)) ++*prox;
+            if (*prox < NFILHOS(fechado)) break;
+            --n_abertos;
+            if (TIPO(fechado) == AST_ENQUANTO) {
+                if (n_lacos + 2 > cap_lacos)
+                    lacos = cresce_pilha(lacos, &cap_lacos, sizeof *lacos);
+                lacos[n_lacos++] = fechado;
+                lacos[n_lacos++] = ultimo;
+            }
+        }
+        if (!n_abertos) break;
+        n = FILHO(abertos[n_abertos - 1].no, abertos[n_abertos - 1].prox++);
+    }
+
+    for (size_t l = 0; l < n_lacos; l += 2) {
+        int ini = (int)lacos[l], fim = (int)lacos[l + 1];
+        for (size_t w = 0; w < n_pal; ++w) {
+            Intervalo *iv = &intervalos[w];
+            if (iv->ini <= fim && iv->fim >= ini) {
+                if (ini < iv->ini) iv->ini = ini;
+                if (fim > iv->fim) iv->fim = fim;
+            }
+        }
+    }
+
+    // Varredura linear: ativos[] guarda as palavras com registrador,
+    // e quando faltam registradores fica no quadro quem vive mais
+    size_t n_vivas = 0;
+    for (size_t w = 0; w < n_pal; ++w)
+        if (intervalos[w].fim >= 0) intervalos[n_vivas++] = intervalos[w];
+    qsort(intervalos, n_vivas, sizeof *intervalos, compara_inicio);
+
+    Intervalo ativos[N_SREG];
+    int n_ativos = 0;
+    for (size_t i = 0; i < n_vivas; ++i) {
+        Intervalo iv = intervalos[i];
+        unsigned livres = (1u << N_SREG) - 1;
+        int k = 0;
+        for (int j = 0; j < n_ativos; ++j) {
+            if (ativos[j].fim < iv.ini) continue;       // expirou
+            livres &= ~(1u << (reg_var[ativos[j].palavra] - R_S0));
+            ativos[k++] = ativos[j];
+        }
+        n_ativos = k;
+        if (n_ativos == N_SREG) {
+            int mais_longa = 0;
+            for (int j = 1; j < n_ativos; ++j)
+                if (ativos[j].fim > ativos[mais_longa].fim) mais_longa = j;
+            if (ativos[mais_longa].fim <= iv.fim) {
+                ++n_vars_memoria;
+                continue;
+            }
+            reg_var[iv.palavra] = reg_var[ativos[mais_longa].palavra];
+            reg_var[ativos[mais_longa].palavra] = 0;
+            ativos[mais_longa] = iv;
+            ++n_vars_memoria;
+            continue;
+        }
+        int r = 0;
+        while (!(livres & (1u << r))) ++r;
+        reg_var[iv.palavra] = (uint8_t)(R_S0 + r);
+        sreg_usados |= 1u << r;
+        ativos[n_ativos++] = iv;
+        ++n_vars_reg;
     }
 }
 
-// Retorna offset em caso de sucesso, ou INT_MAX em caso de falha
-static int frame_map_get_offset(const char *n) {
-    for (int i = 0; i < frame_map_size; ++i)
-        if (strcmp(frame_map[i].nome, n) == 0) return frame_map[i].offset;
-    return INT_MAX; // Sentinela para não encontrado
+
+/* ------------------------------------------------------------------ */
+/* Acesso a variáveis                                                 */
+/* ------------------------------------------------------------------ */
+// O endereço de cada nome já foi resolvido pela análise semântica
+// (ASTC.anot): slot($fp) para parâmetros e locais, var_<nome> para
+// globais. Nenhuma busca por nome acontece aqui. Variáveis alocadas
+// em $s são lidas e escritas com move.
+static void emit_acesso(Mnemonico op, int r, NoId id) {
+    int s = REG_DA_VAR(id);
+    if (s) {
+        if (op == M_LW) { if (r != s) emit_rr(M_MOVE, r, s); }
+        else if (r != s) emit_rr(M_MOVE, s, r);
+    }
+    else if (ANOT(id).lugar == LUGAR_FRAME)
+        emit_mem(op, r, ANOT(id).slot, R_FP);
+    else
+        emit_mem_var(op, r, NOME(ANOT(id).slot));
 }
 
 
-static const char *TREG[] = {"$t0","$t1","$t2","$t3","$t4","$t5","$t6","$t7","$t8","$t9"};
+/* ------------------------------------------------------------------ */
+/* Temporários                                                        */
+/* ------------------------------------------------------------------ */
+// Os valores intermediários formam uma pilha: o temporário k (k-ésimo
+// valor vivo) usa o registrador TREG[k % NTEMP] e, se precisar sair
+// dele, a palavra k da área de temporários do quadro, logo acima dos
+// $s salvos. Antes de escrever no registrador do temporário k, o
+// k - NTEMP (o mais antigo, que será usado por último) é derramado;
+// quem está na memória volta ao registrador quando vira operando. Como
+// só o topo da pilha é liberado, o registrador de um temporário nunca
+// está ocupado por outro vivo quando ele é recarregado.
+// A leitura de uma variável alocada em $s não copia nada: o temporário
+// só aponta para o registrador da variável (T_VARIAVEL).
+// $t0..$t7 seguidos de $t8, $t9
+static const int TREG[] = {8, 9, 10, 11, 12, 13, 14, 15, 24, 25};
 #define NTEMP 10
-static int topo_temp = 0;
 
-static const char *talloc(void) {
-    if (topo_temp >= NTEMP) {
-        fprintf(stderr, "ERRO: Esgotou registradores temporários.\n");
-        exit(1);
+enum {
+    T_MEMORIA,      // só no quadro
+    T_LIMPO,        // no registrador e igual à cópia do quadro
+    T_SUJO,         // só no registrador
+    T_VARIAVEL,     // é o valor atual do $s de uma variável
+};
+
+typedef struct { uint8_t estado, reg_var; } Temp;
+
+static Temp *temps = NULL;          // estado de cada temporário vivo
+static size_t n_temps = 0, cap_temps = 0;
+static int base_temps;              // deslocamento da área no quadro
+static int maior_temp_quadro;       // palavras da área já usadas
+static long n_derramados, n_recargas, n_salvos;     // -ftime-report
+
+#define REG_TEMP(k)   TREG[(k) % NTEMP]
+#define SLOT_TEMP(k)  (base_temps + (int)(k) * WORD_SIZE)
+#define NO_REG(k)     (temps[k].estado == T_LIMPO || temps[k].estado == T_SUJO)
+
+static void guarda_temp(size_t k, int r) {
+    emit_mem(M_SW, r, SLOT_TEMP(k), R_FP);
+    if ((int)k + 1 > maior_temp_quadro) maior_temp_quadro = (int)k + 1;
+}
+
+// O registrador do temporário k vai ser escrito: tira dele o k - NTEMP
+static void ocupa_registro(size_t k) {
+    if (k < NTEMP || !NO_REG(k - NTEMP)) return;
+    if (temps[k - NTEMP].estado == T_SUJO) {
+        guarda_temp(k - NTEMP, REG_TEMP(k));
+        ++n_derramados;
+    }
+    temps[k - NTEMP].estado = T_MEMORIA;
+}
+
+static void empilha_temp(uint8_t estado, int reg) {
+    if (n_temps == cap_temps)
+        temps = cresce_pilha(temps, &cap_temps, sizeof *temps);
+    temps[n_temps++] = (Temp){ estado, (uint8_t)reg };
+}
+
+// Empilha um temporário (sujo) e devolve o registrador dele
+static int talloc(void) {
+    ocupa_registro(n_temps);
+    empilha_temp(T_SUJO, 0);
+    return REG_TEMP(n_temps - 1);
+}
+
+// Empilha a leitura da variável que mora no registrador s
+static void talloc_var(int s) {
+    empilha_temp(T_VARIAVEL, s);
+}
+
+// Registrador com o valor do temporário k, recarregando-o se estiver
+// no quadro
+static int treg(size_t k) {
+    if (temps[k].estado == T_VARIAVEL) return temps[k].reg_var;
+    if (temps[k].estado == T_MEMORIA) {
+        ocupa_registro(k);
+        emit_mem(M_LW, REG_TEMP(k), SLOT_TEMP(k), R_FP);
+        temps[k].estado = T_LIMPO;
+        ++n_recargas;
+    }
+    return REG_TEMP(k);
+}
+
+// O temporário k vai receber um novo valor (os operandos já foram
+// lidos com treg)
+static int tdestino(size_t k) {
+    if (!NO_REG(k)) ocupa_registro(k);
+    temps[k].estado = T_SUJO;
+    return REG_TEMP(k);
+}
+
+#define TOPO_TEMP  (n_temps - 1)
+
+static void tfree(void) { if (n_temps > 0) --n_temps; }
+
+// A variável em s vai mudar: quem ainda aponta para ela guarda o
+// valor antigo no quadro
+static void preserva_leituras(int s) {
+    for (size_t k = 0; k < n_temps; ++k) {
+        if (temps[k].estado == T_VARIAVEL && temps[k].reg_var == s) {
+            guarda_temp(k, s);
+            temps[k].estado = T_MEMORIA;
+        }
     }
-    return TREG[topo_temp++];
 }
-static void tfree(void) { if (topo_temp > 0) --topo_temp; }
 
+// Antes de um jal: quem a função chamada pode destruir vai para o
+// quadro e é recarregado quando for usado ($s ela preserva)
+static void salva_temps(NoId chamada) {
+    int n = 0;
+    for (size_t k = 0; k < n_temps; ++k)
+        if (temps[k].estado == T_SUJO) ++n;
+    if (n > 0) {
+        BufferSaida *c = ir_comentario(&fn);
+        bs_str(c, "Salvando "); bs_int(c, n);
+        bs_str(c, " temporários antes da chamada a '");
+        bs_str(c, NOME(chamada)); bs_char(c, '\'');
+    }
+    for (size_t k = 0; k < n_temps; ++k) {
+        if (temps[k].estado == T_SUJO) {
+            guarda_temp(k, REG_TEMP(k));
+            ++n_salvos;
+        }
+        if (NO_REG(k)) temps[k].estado = T_MEMORIA;
+    }
+}
+
+// Antes de um 'e'/'ou' com valor: os desvios criam caminhos que se
+// juntam depois, e o estado dos temporários vivos tem de ser o mesmo
+// em todos. Tudo vai para o quadro (inclusive leituras de variáveis,
+// se o operador atribui a alguma), e lá fica até a junção.
+static void descarrega_temps(int com_variaveis) {
+    for (size_t k = 0; k < n_temps; ++k) {
+        if (temps[k].estado == T_SUJO) {
+            guarda_temp(k, REG_TEMP(k));
+            ++n_salvos;
+        } else if (temps[k].estado == T_VARIAVEL) {
+            if (!com_variaveis) continue;
+            guarda_temp(k, temps[k].reg_var);
+        }
+        temps[k].estado = T_MEMORIA;
+    }
+}
+
+// Instrução de três registradores de cada operador binário (div, os
+// unários, 'e' e 'ou' têm tratamento próprio)
+static const Mnemonico MNEMONICO_OP[N_OPS] = {
+    [OP_SOMA] = M_ADD, [OP_SUB] = M_SUB, [OP_MUL] = M_MUL,
+    [OP_MENOR] = M_SLT, [OP_MAIOR] = M_SGT,
+    [OP_MENOR_IGUAL] = M_SLE, [OP_MAIOR_IGUAL] = M_SGE,
+    [OP_IGUAL] = M_SEQ, [OP_DIFERENTE] = M_SNE,
+};
+
+// Operadores com forma imediata (as comparações além de slti são
+// pseudoinstruções do SPIM que aceitam um imediato no 3º operando)
+static const Mnemonico MNEMONICO_IMEDIATO[N_OPS] = {
+    [OP_SOMA] = M_ADDI, [OP_SUB] = M_ADDI, [OP_MUL] = M_MUL,
+    [OP_MENOR] = M_SLTI, [OP_MAIOR] = M_SGT,
+    [OP_MENOR_IGUAL] = M_SLE, [OP_MAIOR_IGUAL] = M_SGE,
+    [OP_IGUAL] = M_SEQ, [OP_DIFERENTE] = M_SNE,
+};
+// 'c op x' escrito como 'x ESPELHO[op] c' (OP_NENHUM: não dá)
+static const OpCode ESPELHO[N_OPS] = {
+    [OP_SOMA] = OP_SOMA, [OP_MUL] = OP_MUL,
+    [OP_MENOR] = OP_MAIOR, [OP_MAIOR] = OP_MENOR,
+    [OP_MENOR_IGUAL] = OP_MAIOR_IGUAL, [OP_MAIOR_IGUAL] = OP_MENOR_IGUAL,
+    [OP_IGUAL] = OP_IGUAL, [OP_DIFERENTE] = OP_DIFERENTE,
+};
+
+// Desvio tomado quando a comparação é verdadeira, a comparação
+// contrária (para desviar quando é falsa) e a forma contra zero
+static const Mnemonico DESVIO[N_OPS] = {
+    [OP_MENOR] = M_BLT, [OP_MAIOR] = M_BGT,
+    [OP_MENOR_IGUAL] = M_BLE, [OP_MAIOR_IGUAL] = M_BGE,
+    [OP_IGUAL] = M_BEQ, [OP_DIFERENTE] = M_BNE,
+};
+static const OpCode NEGADO[N_OPS] = {
+    [OP_MENOR] = OP_MAIOR_IGUAL, [OP_MAIOR_IGUAL] = OP_MENOR,
+    [OP_MAIOR] = OP_MENOR_IGUAL, [OP_MENOR_IGUAL] = OP_MAIOR,
+    [OP_IGUAL] = OP_DIFERENTE, [OP_DIFERENTE] = OP_IGUAL,
+};
+static const Mnemonico DESVIO_ZERO[N_OPS] = {
+    [OP_MENOR] = M_BLTZ, [OP_MAIOR] = M_BGTZ,
+    [OP_MENOR_IGUAL] = M_BLEZ, [OP_MAIOR_IGUAL] = M_BGEZ,
+};
+
+#define CABE_IMEDIATO(v)  ((v) >= -32768 && (v) <= 32767)
+
+// Operador binário com um literal que cabe no campo imediato (ou um
+// divisor literal, que vira deslocamentos ou multiplicação): devolve
+// o operando que ainda precisa ser avaliado, o operador (espelhado se
+// o literal estava à esquerda) e o imediato; NO_NULO se não se aplica
+static NoId imediato(NoId e, OpCode *op, long *valor) {
+    if (NFILHOS(e) < 2) return NO_NULO;
+    NoId a = FILHO(e, 0), b = FILHO(e, 1);
+    OpCode o = NO_OP(arv, e);
+    NoId outro = NO_NULO;
+    if (LITERAL(b) && (MNEMONICO_IMEDIATO[o] || o == OP_DIV)) {
+        outro = a;
+        *valor = NO_LITERAL(arv, b);
+    } else if (LITERAL(a) && ESPELHO[o] != OP_NENHUM) {
+        outro = b;
+        o = ESPELHO[o];
+        *valor = NO_LITERAL(arv, a);
+    }
+    if (outro == NO_NULO) return NO_NULO;
+    if (o == OP_SUB) *valor = -*valor;
+    if (!CABE_IMEDIATO(*valor)) return NO_NULO;
+    *op = o;
+    return outro;
+}
+
+
+/* ------------------------------------------------------------------ */
+/* Ordem de avaliação (Sethi–Ullman)                                  */
+/* ------------------------------------------------------------------ */
+// necessidade = quantos temporários a subexpressão ocupa ao mesmo
+// tempo. Uma chamada conta como NTEMP: ela destrói todos os $t, e o
+// que estiver vivo em volta do jal precisa ir para o quadro. Nos
+// operadores e listas de argumentos avalia-se primeiro o operando mais
+// caro, desde que isso não mude o efeito do programa (pode_reordenar).
+#define CUSTO_CHAMADA  NTEMP
+#define CUSTO_MAX      255
+
+enum {
+    C_CHAMADA  = 1,     // contém chamada de função
+    C_ATRIB    = 2,     // contém atribuição
+    C_GLOBAL   = 4,     // lê variável global
+    C_INVERTE  = 8,     // AST_OP: avaliar o operando direito primeiro
+};
+#define C_HERDADAS (C_CHAMADA | C_ATRIB | C_GLOBAL)  // sobem para o pai
+
+typedef struct { uint8_t necessidade, flags; } Custo;
+
+static Custo *custos = NULL;        // um por nó da árvore
+static long n_invertidos;           // -ftime-report
+
+#define ARGS_REG 4                  // $a0..$a3
+
+static int satura(int n) { return n < CUSTO_MAX ? n : CUSTO_MAX; }
+
+// Trocar a ordem de avaliação de subexpressões só é seguro se no
+// máximo uma tem efeito, esse efeito é só chamar funções (que não
+// alcançam as locais) e as outras não leem globais
+static int pode_reordenar(const NoId *itens, int n) {
+    int impuras = 0, globais = 0;
+    for (int i = 0; i < n; ++i) {
+        uint8_t f = custos[itens[i]].flags;
+        if (f & C_ATRIB) return 0;
+        if (f & C_CHAMADA) ++impuras;
+        else if (f & C_GLOBAL) ++globais;
+    }
+    return impuras == 0 || (impuras == 1 && globais == 0);
+}
+
+// Ordem de avaliação dos argumentos de uma chamada (índices em
+// ordem[]): do mais caro para o mais barato, estável; devolve quantos
+static int ordem_argumentos(NoId chamada, int ordem[ARGS_REG]) {
+    if (NFILHOS(chamada) == 0) return 0;
+    NoId lista = FILHO(chamada, 0);
+    int n = NFILHOS(lista) < ARGS_REG ? NFILHOS(lista) : ARGS_REG;
+    NoId itens[ARGS_REG];
+    for (int i = 0; i < n; ++i) {
+        ordem[i] = i;
+        itens[i] = FILHO(lista, i);
+    }
+    if (!pode_reordenar(itens, n)) return n;
+    for (int i = 1; i < n; ++i) {
+        int j = i, k = ordem[i];
+        for (; j > 0 && custos[itens[ordem[j - 1]]].necessidade
+                        < custos[itens[k]].necessidade; --j)
+            ordem[j] = ordem[j - 1];
+        ordem[j] = k;
+    }
+    return n;
+}
+
+// Os filhos vêm depois do pai na pré-ordem: varrendo os nós de trás
+// para a frente, os custos dos filhos já estão prontos
+static void calcula_custos(void) {
+    custos = calloc(arv->n_nos, sizeof *custos);
+    if (!custos) sem_memoria();
+    for (NoId n = arv->n_nos; n-- > 0; ) {
+        Custo *c = &custos[n];
+        switch (TIPO(n)) {
+            case AST_INT: case AST_CAR: case AST_STRING:
+                c->necessidade = 1;
+                break;
+            case AST_ID:
+                c->necessidade = 1;
+                if (ANOT(n).lugar == LUGAR_GLOBAL) c->flags = C_GLOBAL;
+                break;
+            case AST_ATRIB:
+                c->necessidade = custos[FILHO(n, 1)].necessidade;
+                c->flags = (custos[FILHO(n, 1)].flags & C_HERDADAS) | C_ATRIB;
+                break;
+            case AST_OP: {
+                OpCode op = NO_OP(arv, n);
+                long v;
+                if (op == OP_E || op == OP_OU) {
+                    // um operando de cada vez; a ordem não pode mudar
+                    Custo a = custos[FILHO(n, 0)], b = custos[FILHO(n, 1)];
+                    c->necessidade = a.necessidade > b.necessidade
+                                     ? a.necessidade : b.necessidade;
+                    c->flags = (a.flags | b.flags) & C_HERDADAS;
+                    break;
+                }
+                NoId so = imediato(n, &op, &v);
+                Custo a = custos[so != NO_NULO ? so : FILHO(n, 0)];
+                a.flags &= C_HERDADAS;
+                if (NFILHOS(n) < 2 || so != NO_NULO) { *c = a; break; }
+                Custo b = custos[FILHO(n, 1)];
+                NoId itens[2] = { FILHO(n, 0), FILHO(n, 1) };
+                c->flags = a.flags | (b.flags & C_HERDADAS);
+                if (b.necessidade > a.necessidade && pode_reordenar(itens, 2)) {
+                    c->flags |= C_INVERTE;
+                    c->necessidade = b.necessidade;
+                } else {
+                    c->necessidade = satura(a.necessidade > b.necessidade
+                                            ? a.necessidade : b.necessidade + 1);
+                }
+                break;
+            }
+            case AST_CHAMADA_FUNCAO: {
+                // os argumentos ficam em temporários até o jal
+                int ordem[ARGS_REG], n_args = ordem_argumentos(n, ordem);
+                int nec = CUSTO_CHAMADA;
+                c->flags = C_CHAMADA;
+                for (int j = 0; j < n_args; ++j) {
+                    Custo arg = custos[FILHO(FILHO(n, 0), ordem[j])];
+                    if (j + arg.necessidade > nec) nec = j + arg.necessidade;
+                    c->flags |= arg.flags & C_HERDADAS;
+                }
+                c->necessidade = satura(nec);
+                break;
+            }
+            default:
+                break;
+        }
+    }
+}
 
 /* ------------------------------------------------------------------ */
 /* Passada 1: Coleta de Strings Literais                              */
@@ -109,22 +664,21 @@ static void tfree(void) { if (topo_temp > 0) --topo_temp; }
 
 static void adiciona_string_a_lista(const char* valor) {
     for (StringLiteral* p = lista_strings; p != NULL; p = p->next) {
-        if (strcmp(p->valor, valor) == 0) return;
+        if (p->valor == valor) return;
     }
     StringLiteral* novo = malloc(sizeof(StringLiteral));
-    novo->valor = strdup(valor);
-    snprintf(novo->label, sizeof(novo->label), "str%d", string_id_counter++);
+    novo->valor = valor;
+    novo->id = string_id_counter++;
     novo->next = lista_strings;
     lista_strings = novo;
 }
 
-static void coleta_strings_pass(AST* no) {
-    if (!no) return;
-    if (no->tipo == AST_STRING) {
-        adiciona_string_a_lista(no->valor);
-    }
-    for (int i = 0; i < no->n_filhos; ++i) {
-        coleta_strings_pass(no->filhos[i]);
+// Os nós estão em pré-ordem: uma varredura linear basta
+static void coleta_strings_pass(void) {
+    for (NoId n = 0; n < arv->n_nos; ++n) {
+        if (TIPO(n) == AST_STRING) {
+            adiciona_string_a_lista(NOME(n));
+        }
     }
 }
 
@@ -132,346 +686,809 @@ static void coleta_strings_pass(AST* no) {
 /* Passada 2: Geração de Código                                       */
 /* ------------------------------------------------------------------ */
 
-static void gera_secao_data(AST* raiz) {
-    emit(".data\n");
-    emit("nl: .asciiz \"\n\"\n");
+// Vai depois das funções: só entram as strings que algum 'la' ainda
+// usa depois dos passes (as de ramos mortos e de código inalcançável
+// ficam de fora)
+static void gera_secao_data(NoId raiz) {
+    bs_str(out, "\n.data\n");
+    bs_str(out, "nl: .asciiz \"\n\"\n");
 
     for (StringLiteral* p = lista_strings; p != NULL; p = p->next) {
-        emit("%s: .asciiz %s\n", p->label, p->valor);
+        if (!string_usada[p->id]) {
+            ++n_strings_omitidas;
+            continue;
+        }
+        bs_bytes(out, "str", 3);
+        bs_int(out, p->id);
+        bs_bytes(out, ": .asciiz ", 10);
+        bs_bytes(out, p->valor, intern_tamanho(p->valor));
+        bs_char(out, '\n');
     }
 
-    if (raiz->n_filhos > 0 && raiz->filhos[0]) {
-        AST *lista = raiz->filhos[0];
-        char var_label[256];
-        for (int i = 0; i < lista->n_filhos; ++i) {
-            AST *item = lista->filhos[i];
-            if (item->tipo == AST_DECL_VARIAVEL) {
-                gera_nome_label_var(item->valor, var_label, sizeof(var_label));
-                emit("%s: .word 0\n", var_label);
+    if (NFILHOS(raiz) > 0) {
+        NoId lista = FILHO(raiz, 0);
+        for (int i = 0; i < NFILHOS(lista); ++i) {
+            NoId item = FILHO(lista, i);
+            if (TIPO(item) == AST_DECL_VARIAVEL) {
+                emite_rotulo_var(out, NOME(item));
+                bs_bytes(out, ": .word 0\n", 10);
             }
         }
     }
 }
 
-static const char* obter_label_string(const char* valor) {
+static int obter_id_string(const char* valor) {
     for (StringLiteral* p = lista_strings; p != NULL; p = p->next) {
-        if (strcmp(p->valor, valor) == 0) return p->label;
+        if (p->valor == valor) return p->id;
     }
-    return NULL;
+    return -1;
+}
+
+
+/* ------------------------------------------------------------------ */
+/* Percurso com pilha explícita                                       */
+/* ------------------------------------------------------------------ */
+// Comandos e expressões são gerados sem recursão: cada passo é uma
+// tarefa numa pilha (empilhada na ordem inversa da execução) e o
+// resultado de cada subexpressão fica no topo da pilha de temporários.
+// A profundidade da árvore não consome a pilha de C.
+typedef enum {
+    G_COMANDO,       // visita um comando
+    G_EXPR,          // visita uma expressão
+    G_OP,            // operandos prontos: aplica o operador
+    G_ATRIB,         // valor pronto: grava na variável
+    G_CHAMADA,       // argumentos prontos: passa em $a0..$a3 e jal
+    G_DESCARTA,      // libera o valor de uma expressão-comando
+    G_ESCRITA,
+    G_RETORNE,
+    G_DESVIA_FALSO,  // condição pronta: desvia para L<aux> se for 0
+    G_DESVIA_VERDADE,// condição pronta: desvia para L<aux> se não for 0
+    G_SE_FALSO,      // desvia para L<aux> se a condição for falsa
+    G_SE_VERDADE,    // desvia para L<aux> se a condição for verdadeira
+    G_COMPARA_FALSO, // operandos prontos: desvia se a comparação for falsa
+    G_COMPARA_VERDADE,// ... se a comparação for verdadeira
+    G_LOGICO,        // 'e'/'ou' com valor: 0 ou 1 (desvios para L<aux>)
+    G_SALTA,         // j L<aux>
+    G_ROTULO,        // L<aux>:
+} PassoGer;
+
+typedef struct { NoId no; uint8_t passo; int aux; } TarefaGer;
+
+static TarefaGer *tarefas = NULL;
+static size_t n_tarefas = 0, cap_tarefas = 0;
+static int rotulo_saida_func;       // epílogo da função em geração
+
+static void *cresce_pilha(void *p, size_t *cap, size_t tam) {
+    *cap = *cap ? 2 * *cap : 1024;
+    p = realloc(p, *cap * tam);
+    if (!p) sem_memoria();
+    return p;
+}
+
+static void empilha(PassoGer passo, NoId no, int aux) {
+    if (n_tarefas == cap_tarefas)
+        tarefas = cresce_pilha(tarefas, &cap_tarefas, sizeof *tarefas);
+    tarefas[n_tarefas++] = (TarefaGer){ no, (uint8_t)passo, aux };
 }
 
+// Operandos de um operador: só o não-literal se houver imediato
+// ('so'), senão os dois na ordem escolhida em calcula_custos
+static void empilha_operandos(NoId e, NoId so) {
+    if (NFILHOS(e) < 2 || so != NO_NULO) {
+        empilha(G_EXPR, so != NO_NULO ? so : FILHO(e, 0), 0);
+    } else if (custos[e].flags & C_INVERTE) {
+        empilha(G_EXPR, FILHO(e, 0), 0);
+        empilha(G_EXPR, FILHO(e, 1), 0);
+        ++n_invertidos;
+    } else {
+        empilha(G_EXPR, FILHO(e, 1), 0);
+        empilha(G_EXPR, FILHO(e, 0), 0);
+    }
+}
 
-static const char *gera_expr(AST *e) {
-    if (!e) return NULL;
-    switch (e->tipo) {
-        case AST_INT: {
-            const char *t = talloc();
-            emit("    li %s, %s\n", t, e->valor);
-            return t;
+// Desvia para L<rotulo> quando o valor de verdade de e for
+// 'se_verdade'; senão segue adiante. 'e' e 'ou' viram desvios
+// encadeados: o operando direito só é avaliado se o esquerdo não
+// decidir. Comparações desviam direto sobre os operandos (blt, beq,
+// ...) sem montar o 0/1, e '!' só inverte o sentido do desvio.
+static void visita_condicao(NoId e, int rotulo, int se_verdade) {
+    if (LITERAL(e)) {
+        if ((NO_LITERAL(arv, e) != 0) == se_verdade) emit_j(rotulo);
+        return;
+    }
+    OpCode op = TIPO(e) == AST_OP ? NO_OP(arv, e) : OP_NENHUM;
+    if (op == OP_E || op == OP_OU) {
+        PassoGer passo = se_verdade ? G_SE_VERDADE : G_SE_FALSO;
+        if ((op == OP_E) != se_verdade) {
+            // 'a e b' falso ou 'a ou b' verdadeiro: qualquer um decide
+            empilha(passo, FILHO(e, 1), rotulo);
+            empilha(passo, FILHO(e, 0), rotulo);
+        } else {
+            // senão o esquerdo só decide no outro sentido, pulando o
+            // direito
+            int segue = novo_rotulo();
+            empilha(G_ROTULO, e, segue);
+            empilha(passo, FILHO(e, 1), rotulo);
+            empilha(se_verdade ? G_SE_FALSO : G_SE_VERDADE, FILHO(e, 0), segue);
         }
+        return;
+    }
+    if (op == OP_NAO) {
+        empilha(se_verdade ? G_SE_FALSO : G_SE_VERDADE, FILHO(e, 0), rotulo);
+        return;
+    }
+    if (DESVIO[op]) {
+        long v;
+        NoId so = imediato(e, &op, &v);
+        empilha(se_verdade ? G_COMPARA_VERDADE : G_COMPARA_FALSO, e, rotulo);
+        empilha_operandos(e, so);
+        return;
+    }
+    empilha(se_verdade ? G_DESVIA_VERDADE : G_DESVIA_FALSO, e, rotulo);
+    empilha(G_EXPR, e, 0);
+}
+
+// Operandos de uma comparação prontos no topo: desvia para L<rotulo>
+// se ela der 'se_verdade'
+static void fecha_compara(NoId e, int rotulo, int se_verdade) {
+    OpCode op = NO_OP(arv, e);
+    long v;
+    if (imediato(e, &op, &v) != NO_NULO) {
+        if (!se_verdade) op = NEGADO[op];
+        int a = treg(TOPO_TEMP);
+        if (v == 0 && DESVIO_ZERO[op]) emit_desvio_zero(DESVIO_ZERO[op], a, rotulo);
+        else if (v == 0) emit_desvio(DESVIO[op], a, R_ZERO, rotulo);
+        else emit_desvio_imediato(DESVIO[op], a, v, rotulo);
+        tfree();
+        return;
+    }
+    int inverte = custos[e].flags & C_INVERTE;
+    int a = treg(inverte ? TOPO_TEMP : TOPO_TEMP - 1);
+    int b = treg(inverte ? TOPO_TEMP - 1 : TOPO_TEMP);
+    if (!se_verdade) op = NEGADO[op];
+    emit_desvio(DESVIO[op], a, b, rotulo);
+    tfree();
+    tfree();
+}
+
+// Fim de um 'e'/'ou' com valor: quem chegou até aqui sem desviar tem
+// o resultado "contrário" ao do rótulo de desvio (aux); o fim é aux+1
+static void fecha_logico(NoId e, int desvio) {
+    int ou = NO_OP(arv, e) == OP_OU;
+    int r = talloc();
+    emit_ri(M_LI, r, !ou);
+    emit_j(desvio + 1);
+    emit_rotulo(desvio);
+    emit_ri(M_LI, r, ou);
+    emit_rotulo(desvio + 1);
+}
+
+static void visita_expr(NoId e) {
+    switch (TIPO(e)) {
+        case AST_INT:
         case AST_CAR: {
-            const char *t = talloc();
-            emit("    li %s, %d\n", t, e->valor[1]);
-            return t;
+            int t = talloc();
+            emit_ri(M_LI, t, NO_LITERAL(arv, e));
+            return;
         }
         case AST_STRING: {
-            const char *t = talloc();
-            const char *label_str = obter_label_string(e->valor);
-            emit("    la %s, %s\n", t, label_str);
-            return t;
+            int t = talloc();
+            ir_instr(&fn, M_LA, 2, ir_reg(t), ir_str(obter_id_string(NOME(e))), ir_nada());
+            return;
         }
         case AST_ID: {
-            const char *t = talloc();
-            int off = frame_map_get_offset(e->valor);
-            if (off != INT_MAX) {
-                emit("    lw %s, %d($fp)\n", t, off);
-            } else {
-                char var_label[256];
-                gera_nome_label_var(e->valor, var_label, sizeof(var_label));
-                emit("    lw %s, %s\n", t, var_label);
+            if (REG_DA_VAR(e)) {
+                talloc_var(REG_DA_VAR(e));
+                return;
             }
-            return t;
+            int t = talloc();
+            emit_acesso(M_LW, t, e);
+            return;
         }
         case AST_ATRIB: {
-            const char *rhs = gera_expr(e->filhos[1]);
-            const char *id_name = e->filhos[0]->valor;
-            int off = frame_map_get_offset(id_name);
-            if (off != INT_MAX) {
-                emit("    sw %s, %d($fp)\n", rhs, off);
-            } else {
-                char var_label[256];
-                gera_nome_label_var(id_name, var_label, sizeof(var_label));
-                emit("    sw %s, %s\n", rhs, var_label);
+            // literal numa variável em registrador: li direto no $s
+            NoId var = FILHO(e, 0), val = FILHO(e, 1);
+            if (LITERAL(val) && REG_DA_VAR(var)) {
+                preserva_leituras(REG_DA_VAR(var));
+                emit_ri(M_LI, REG_DA_VAR(var), NO_LITERAL(arv, val));
+                talloc_var(REG_DA_VAR(var));
+                return;
             }
-            return rhs;
+            empilha(G_ATRIB, e, 0);
+            empilha(G_EXPR, FILHO(e, 1), 0);
+            return;
         }
         case AST_OP: {
-            const char *a = gera_expr(e->filhos[0]);
-            if (e->n_filhos == 1) {
-                 if (!strcmp(e->valor, "uminus")) emit("    sub %s, $zero, %s\n", a, a);
-                 else if (!strcmp(e->valor, "!")) emit("    seq %s, %s, $zero\n", a, a);
-                 return a;
+            OpCode op = NO_OP(arv, e);
+            long v;
+            if (op == OP_E || op == OP_OU) {
+                // os temporários vivos são os mesmos nos dois caminhos
+                descarrega_temps(custos[e].flags & C_ATRIB);
+                int desvio = novo_rotulo();
+                novo_rotulo();                      // desvio + 1: fim
+                empilha(G_LOGICO, e, desvio);
+                visita_condicao(e, desvio, op == OP_OU);
+                return;
             }
-            const char *b = gera_expr(e->filhos[1]);
-            if (!strcmp(e->valor, "+")) emit("    add %s, %s, %s\n", a, a, b);
-            else if (!strcmp(e->valor, "-")) emit("    sub %s, %s, %s\n", a, a, b);
-            else if (!strcmp(e->valor, "*")) emit("    mul %s, %s, %s\n", a, a, b);
-            else if (!strcmp(e->valor, "/")) { emit("    div %s, %s\n", a, b); emit("    mflo %s\n", a); }
-            else if (!strcmp(e->valor, "<")) emit("    slt %s, %s, %s\n", a, a, b);
-            else if (!strcmp(e->valor, ">")) emit("    sgt %s, %s, %s\n", a, a, b);
-            else if (!strcmp(e->valor, "<=")) emit("    sle %s, %s, %s\n", a, a, b);
-            else if (!strcmp(e->valor, ">=")) emit("    sge %s, %s, %s\n", a, a, b);
-            else if (!strcmp(e->valor, "==")) emit("    seq %s, %s, %s\n", a, a, b);
-            else if (!strcmp(e->valor, "!=")) emit("    sne %s, %s, %s\n", a, a, b);
-            else if (!strcmp(e->valor, "e")) emit("    and %s, %s, %s\n", a, a, b);
-            else if (!strcmp(e->valor, "ou")) emit("    or %s, %s, %s\n", a, a, b);
-            tfree();
-            return a;
+            NoId so = imediato(e, &op, &v);
+            empilha(G_OP, e, 0);
+            empilha_operandos(e, so);
+            return;
         }
         case AST_CHAMADA_FUNCAO: {
-            int n_args = (e->n_filhos > 0 && e->filhos[0]) ? e->filhos[0]->n_filhos : 0;
-
-            // Salvar registradores temporários em uso
-            int regs_em_uso = topo_temp;
-            if (regs_em_uso > 0) {
-                emit("    # Salvando %d temporários antes da chamada a '%s'\n", regs_em_uso, e->valor);
-                emit("    addi $sp, $sp, -%d\n", regs_em_uso * WORD_SIZE);
-                for (int i = 0; i < regs_em_uso; ++i) {
-                    emit("    sw   %s, %d($sp)\n", TREG[i], i * WORD_SIZE);
-                }
-            }
+            // Avaliar os argumentos em temporários, do mais caro para
+            // o mais barato; só passam para $a<i> antes do jal, para
+            // que chamadas dentro de outro argumento não os destruam
+            int ordem[ARGS_REG], n_args = ordem_argumentos(e, ordem);
+            empilha(G_CHAMADA, e, 0);
+            for (int j = n_args - 1; j >= 0; --j)
+                empilha(G_EXPR, FILHO(FILHO(e, 0), ordem[j]), 0);
+            for (int j = 0; j < n_args; ++j)
+                if (ordem[j] != j) { ++n_invertidos; break; }
+            return;
+        }
+        default:
+            talloc();
+            return;
+    }
+}
 
-            // Avaliar e passar argumentos
-            for (int i = 0; i < n_args && i < 4; ++i) {
-                const char *r = gera_expr(e->filhos[0]->filhos[i]);
-                emit("    move $a%d, %s\n", i, r);
-                tfree();
-            }
+/* ------------------------------------------------------------------ */
+/* Multiplicação e divisão por constantes                             */
+/* ------------------------------------------------------------------ */
+// mul e div são as instruções inteiras mais lentas do MIPS. Com um
+// literal, a multiplicação vira deslocamentos e somas quando bastam
+// poucas instruções, e a divisão vira deslocamentos (potência de 2) ou
+// uma multiplicação pelo "número mágico" do divisor, ficando com a
+// parte alta (Granlund–Montgomery / Hacker's Delight, cap. 10). $v1 é
+// o registrador auxiliar dessas sequências. Os resultados são os mesmos
+// de mul e div, inclusive no arredondamento para zero. mul não sinaliza
+// estouro, mas add e sub sim; por isso as sequências somam com addu e
+// subu, que dão o resultado módulo 2^32 mesmo quando um deslocamento
+// intermediário estoura e o produto final cabe (x * 7 com x = 3*10^8).
+static long n_mul_reduzidas, n_div_reduzidas;   // -ftime-report
 
-            // Chamar a função
-            char label_chamada[256];
-            gera_nome_label_func(e->valor, label_chamada, sizeof(label_chamada));
-            emit("    jal  %s\n", label_chamada);
+// k se v == 2^k, senão -1
+static int log2_exato(unsigned long v) {
+    if (v == 0 || (v & (v - 1))) return -1;
+    int k = 0;
+    while (v >>= 1) ++k;
+    return k;
+}
 
-            // Restaurar registradores temporários
-            if (regs_em_uso > 0) {
-                emit("    # Restaurando %d temporários após a chamada\n", regs_em_uso);
-                for (int i = 0; i < regs_em_uso; ++i) {
-                    emit("    lw   %s, %d($sp)\n", TREG[i], i * WORD_SIZE);
-                }
-                emit("    addi $sp, $sp, %d\n", regs_em_uso * WORD_SIZE);
-            }
+// Só a multiplicação por |c|; o sinal fica para quem chama.
+// 0 se não há sequência de até três instruções.
+static int multiplica_positivo(int res, int a, unsigned long c) {
+    int k = log2_exato(c), m;
+    if (k == 0) {
+        emit_rr(M_MOVE, res, a);
+    } else if (k > 0) {
+        emit_rri(M_SLL, res, a, k);
+    } else if ((k = log2_exato(c - 1)) >= 0) {           // 2^k + 1
+        emit_rri(M_SLL, R_V1, a, k);
+        emit_rrr(M_ADDU, res, R_V1, a);
+    } else if ((k = log2_exato(c + 1)) >= 0) {           // 2^k - 1
+        emit_rri(M_SLL, R_V1, a, k);
+        emit_rrr(M_SUBU, res, R_V1, a);
+    } else if ((m = log2_exato(c & -c)) >= 0
+               && (k = log2_exato(c - (c & -c))) >= 0) { // 2^k + 2^m
+        emit_rri(M_SLL, R_V1, a, k);
+        emit_rri(M_SLL, res, a, m);
+        emit_rrr(M_ADDU, res, res, R_V1);
+    } else {
+        return 0;
+    }
+    return 1;
+}
 
-            // Mover valor de retorno para um novo temporário
-            const char *ret = talloc();
-            emit("    move %s, $v0\n", ret);
-            return ret;
-        }
-        default: break;
+static void multiplica_constante(int res, int a, long c) {
+    if (c == 0) {
+        emit_ri(M_LI, res, 0);
+    } else if (c == -1) {
+        emit_rrr(M_SUBU, res, R_ZERO, a);
+    } else if (multiplica_positivo(res, a, c < 0 ? -c : c)) {
+        if (c < 0) emit_rrr(M_SUBU, res, R_ZERO, res);
+    } else {
+        emit_rri(M_MUL, res, a, c);
+        return;
+    }
+    ++n_mul_reduzidas;
+}
+
+// Número mágico m e deslocamento s da divisão com sinal por d >= 2:
+// a / d == ((a * m) >> (32 + s)) + (a < 0), somando a antes do
+// deslocamento quando m sai negativo
+static void numero_magico(uint32_t d, int32_t *m, int *s) {
+    const uint32_t dois31 = 0x80000000u;
+    uint32_t anc = dois31 - 1 - dois31 % d;
+    uint32_t q1 = dois31 / anc, r1 = dois31 - q1 * anc;
+    uint32_t q2 = dois31 / d, r2 = dois31 - q2 * d;
+    uint32_t delta;
+    int p = 31;
+    do {
+        ++p;
+        q1 *= 2; r1 *= 2;
+        if (r1 >= anc) { ++q1; r1 -= anc; }
+        q2 *= 2; r2 *= 2;
+        if (r2 >= d) { ++q2; r2 -= d; }
+        delta = d - r2;
+    } while (q1 < delta || (q1 == delta && r1 == 0));
+    *m = (int32_t)(q2 + 1);
+    *s = p - 32;
+}
+
+static void divide_constante(int res, int a, long d) {
+    unsigned long ad = d < 0 ? -d : d;
+    int k = log2_exato(ad);
+    if (d == 0) {                   // o erro fica para a execução
+        emit_ri(M_LI, R_V1, 0);
+        emit_rr(M_DIV, a, R_V1);
+        emit_r(M_MFLO, res);
+        return;
+    }
+    if (d == -1) {
+        emit_rrr(M_SUBU, res, R_ZERO, a);
+        ++n_div_reduzidas;
+        return;
+    }
+    if (k == 0) {
+        emit_rr(M_MOVE, res, a);
+    } else if (k > 0) {
+        // negativos somam 2^k - 1 antes do deslocamento, para que o
+        // arredondamento seja para zero
+        if (k > 1) emit_rri(M_SRA, R_V1, a, 31);
+        emit_rri(M_SRL, R_V1, k > 1 ? R_V1 : a, 32 - k);
+        emit_rrr(M_ADDU, R_V1, a, R_V1);
+        emit_rri(M_SRA, res, R_V1, k);
+    } else {
+        int32_t m;
+        int s;
+        numero_magico((uint32_t)ad, &m, &s);
+        emit_ri(M_LI, R_V1, m);
+        emit_rr(M_MULT, a, R_V1);
+        emit_r(M_MFHI, R_V1);
+        if (m < 0) emit_rrr(M_ADDU, R_V1, R_V1, a);
+        if (s > 0) emit_rri(M_SRA, R_V1, R_V1, s);
+        emit_rri(M_SRL, res, a, 31);
+        emit_rrr(M_ADDU, res, R_V1, res);
+    }
+    if (d < 0) emit_rrr(M_SUBU, res, R_ZERO, res);
+    ++n_div_reduzidas;
+}
+
+static void fecha_op(NoId e) {
+    OpCode op = NO_OP(arv, e);
+    long v;
+    if (imediato(e, &op, &v) != NO_NULO) {
+        int a = treg(TOPO_TEMP);
+        int res = tdestino(TOPO_TEMP);
+        if (op == OP_MUL) multiplica_constante(res, a, v);
+        else if (op == OP_DIV) divide_constante(res, a, v);
+        else emit_rri(MNEMONICO_IMEDIATO[op], res, a, v);
+        return;
+    }
+    if (NFILHOS(e) < 2) {
+        int a = treg(TOPO_TEMP);
+        int res = tdestino(TOPO_TEMP);
+        if (op == OP_NEG) emit_rrr(M_SUB, res, R_ZERO, a);
+        else emit_rrr(M_SEQ, res, a, R_ZERO);       // OP_NAO
+        return;
+    }
+    // o resultado fica sempre no temporário de baixo; com C_INVERTE é
+    // nele que está o operando direito
+    int inverte = custos[e].flags & C_INVERTE;
+    int a = treg(inverte ? TOPO_TEMP : TOPO_TEMP - 1);
+    int b = treg(inverte ? TOPO_TEMP - 1 : TOPO_TEMP);
+    int res = tdestino(TOPO_TEMP - 1);
+    if (op == OP_DIV) { emit_rr(M_DIV, a, b); emit_r(M_MFLO, res); }
+    else emit_rrr(MNEMONICO_OP[op], res, a, b);
+    tfree();
+}
+
+static void fecha_chamada(NoId e) {
+    // Passar os argumentos, que estão no topo na ordem de avaliação
+    int ordem[ARGS_REG], n_args = ordem_argumentos(e, ordem);
+    for (int j = 0; j < n_args; ++j)
+        emit_rr(M_MOVE, R_A0 + ordem[j], treg(n_temps - n_args + j));
+    for (int j = 0; j < n_args; ++j) tfree();
+
+    // Chamar a função (rótulo vem da declaração resolvida); os
+    // temporários vivos voltam do quadro quando forem usados
+    salva_temps(e);
+    ir_instr(&fn, M_JAL, 1, ir_func(NOME(ANOT(e).slot)), ir_nada(), ir_nada());
+
+    // Mover valor de retorno para um novo temporário
+    int ret = talloc();
+    emit_rr(M_MOVE, ret, R_V0);
+}
+
+static void fecha_escrita(NoId c) {
+    NoId expr = FILHO(c, 0);
+    emit_rr(M_MOVE, R_A0, treg(TOPO_TEMP));
+    if (TIPO(expr) == AST_STRING) {
+        emit_ri(M_LI, R_V0, 4);
+    } else if (ANOT(expr).tipo == TIPO_CAR) {
+        emit_ri(M_LI, R_V0, 11);
+    } else {
+        emit_ri(M_LI, R_V0, 1);
     }
-    return NULL;
+    emit_syscall();
+    tfree();
 }
 
-static void gera_comando(AST *c, const char *rotulo_saida_func) {
-    if (!c) return;
-    switch (c->tipo) {
+static void visita_comando(NoId c) {
+    switch (TIPO(c)) {
         case AST_LISTA_COMANDO:
-            for (int i = 0; i < c->n_filhos; ++i)
-                gera_comando(c->filhos[i], rotulo_saida_func);
+            for (int i = NFILHOS(c) - 1; i >= 0; --i)
+                empilha(G_COMANDO, FILHO(c, i), 0);
             break;
         case AST_ATRIB:
         case AST_CHAMADA_FUNCAO:
-            gera_expr(c);
-            tfree();
+        case AST_OP:                // "f(x) + 1;": o valor é descartado
+            empilha(G_DESCARTA, c, 0);
+            empilha(G_EXPR, c, 0);
             break;
-        case AST_LEITURA: {
-            emit("    li $v0, 5\n"); // syscall 5 para ler inteiro
-            emit("    syscall\n");
-            const char *id_name = c->filhos[0]->valor;
-            int off = frame_map_get_offset(id_name);
-            if (off != INT_MAX) {
-                emit("    sw $v0, %d($fp)\n", off);
-            } else {
-                char var_label[256];
-                gera_nome_label_var(id_name, var_label, sizeof(var_label));
-                emit("    sw $v0, %s\n", var_label);
-            }
+        case AST_LEITURA:
+            emit_ri(M_LI, R_V0, 5); // syscall 5 para ler inteiro
+            emit_syscall();
+            emit_acesso(M_SW, R_V0, FILHO(c, 0));
             break;
-        }
-        case AST_ESCRITA: {
-            AST *expr = c->filhos[0];
-            const char *reg = gera_expr(expr);
-            emit("    move $a0, %s\n", reg);
-            if (expr->tipo == AST_STRING) {
-                emit("    li $v0, 4\n");
-            } else if (expr->tipo == AST_CAR) {
-                emit("    li $v0, 11\n");
-            } else {
-                emit("    li $v0, 1\n");
-            }
-            emit("    syscall\n");
-            tfree();
+        case AST_ESCRITA:
+            empilha(G_ESCRITA, c, 0);
+            empilha(G_EXPR, FILHO(c, 0), 0);
             break;
-        }
         case AST_NOVALINHA:
-            emit("    la $a0, nl\n");
-            emit("    li $v0, 4\n");
-            emit("    syscall\n");
+            ir_instr(&fn, M_LA, 2, ir_reg(R_A0), ir_simbolo("nl"), ir_nada());
+            emit_ri(M_LI, R_V0, 4);
+            emit_syscall();
             break;
-        case AST_RETORNE: {
-            const char *r = gera_expr(c->filhos[0]);
-            emit("    move $v0, %s\n", r);
-            tfree();
-            emit("    j %s\n", rotulo_saida_func);
+        case AST_RETORNE:
+            empilha(G_RETORNE, c, 0);
+            empilha(G_EXPR, FILHO(c, 0), 0);
             break;
-        }
         case AST_SE: {
-            char rot_fim[32]; novo_rotulo(rot_fim, sizeof(rot_fim));
-            const char *cond = gera_expr(c->filhos[0]);
-            emit("    beq %s, $zero, %s\n", cond, rot_fim);
-            tfree();
-            gera_comando(c->filhos[1], rotulo_saida_func);
-            emit("%s:\n", rot_fim);
+            int v = condicao_constante(c);
+            if (v >= 0) {
+                if (v) empilha(G_COMANDO, FILHO(c, 1), 0);
+                ++n_ramos_constantes;
+                break;
+            }
+            int rot_fim = novo_rotulo();
+            empilha(G_ROTULO, c, rot_fim);
+            empilha(G_COMANDO, FILHO(c, 1), 0);
+            empilha(G_SE_FALSO, FILHO(c, 0), rot_fim);
             break;
         }
         case AST_SENAO: {
-            AST *no_se = c->filhos[0];
-            char rot_senao[32], rot_fim[32];
-            novo_rotulo(rot_senao, sizeof(rot_senao));
-            novo_rotulo(rot_fim, sizeof(rot_fim));
-            const char *cond = gera_expr(no_se->filhos[0]);
-            emit("    beq %s, $zero, %s\n", cond, rot_senao);
-            tfree();
-            gera_comando(no_se->filhos[1], rotulo_saida_func);
-            emit("    j %s\n", rot_fim);
-            emit("%s:\n", rot_senao);
-            gera_comando(c->filhos[1], rotulo_saida_func);
-            emit("%s:\n", rot_fim);
+            NoId no_se = FILHO(c, 0);
+            int v = condicao_constante(c);
+            if (v >= 0) {
+                empilha(G_COMANDO, v ? FILHO(no_se, 1) : FILHO(c, 1), 0);
+                ++n_ramos_constantes;
+                break;
+            }
+            int rot_senao = novo_rotulo();
+            int rot_fim = novo_rotulo();
+            empilha(G_ROTULO, c, rot_fim);
+            empilha(G_COMANDO, FILHO(c, 1), 0);
+            empilha(G_ROTULO, c, rot_senao);
+            empilha(G_SALTA, c, rot_fim);
+            empilha(G_COMANDO, FILHO(no_se, 1), 0);
+            empilha(G_SE_FALSO, FILHO(no_se, 0), rot_senao);
             break;
         }
         case AST_ENQUANTO: {
-            char rot_inicio[32], rot_fim[32];
-            novo_rotulo(rot_inicio, sizeof(rot_inicio));
-            novo_rotulo(rot_fim, sizeof(rot_fim));
-            emit("%s:\n", rot_inicio);
-            const char *cond = gera_expr(c->filhos[0]);
-            emit("    beq %s, $zero, %s\n", cond, rot_fim);
-            tfree();
-            gera_comando(c->filhos[1], rotulo_saida_func);
-            emit("    j %s\n", rot_inicio);
-            emit("%s:\n", rot_fim);
+            // Laço rodado: a condição é testada uma vez na entrada e
+            // depois no fim do corpo, que volta para o início se ela
+            // ainda valer. Cada volta executa um desvio só, não um
+            // teste e um 'j'.
+            if (condicao_constante(c) == 0) {
+                ++n_ramos_constantes;
+                break;
+            }
+            int rot_corpo = novo_rotulo();
+            int rot_fim = novo_rotulo();
+            empilha(G_ROTULO, c, rot_fim);
+            empilha(G_SE_VERDADE, FILHO(c, 0), rot_corpo);
+            empilha(G_COMANDO, FILHO(c, 1), 0);
+            empilha(G_ROTULO, c, rot_corpo);
+            empilha(G_SE_FALSO, FILHO(c, 0), rot_fim);
             break;
         }
         case AST_BLOCO:
-            if(c->n_filhos > 1 && c->filhos[1]) {
-                 gera_comando(c->filhos[1], rotulo_saida_func);
+            if(NFILHOS(c) > 1) {
+                 empilha(G_COMANDO, FILHO(c, 1), 0);
             }
             break;
         default: break;
     }
 }
 
-static void gera_funcao(AST *decl) {
-    const char *nome_original = decl->valor;
-    AST *bloco = NULL, *listaParam = NULL;
+// Executa as tarefas até esvaziar a pilha
+static void executa(void) {
+    while (n_tarefas) {
+        TarefaGer t = tarefas[--n_tarefas];
+        switch ((PassoGer)t.passo) {
+            case G_COMANDO: visita_comando(t.no); break;
+            case G_EXPR:    visita_expr(t.no); break;
+            case G_OP:      fecha_op(t.no); break;
+            case G_ATRIB: {
+                NoId var = FILHO(t.no, 0);
+                if (REG_DA_VAR(var)) preserva_leituras(REG_DA_VAR(var));
+                emit_acesso(M_SW, treg(TOPO_TEMP), var);
+                break;
+            }
+            case G_CHAMADA: fecha_chamada(t.no); break;
+            case G_DESCARTA:
+                tfree();
+                break;
+            case G_ESCRITA: fecha_escrita(t.no); break;
+            case G_RETORNE:
+                emit_rr(M_MOVE, R_V0, treg(TOPO_TEMP));
+                tfree();
+                emit_j(rotulo_saida_func);
+                break;
+            case G_DESVIA_FALSO:
+                emit_desvio(M_BEQ, treg(TOPO_TEMP), R_ZERO, t.aux);
+                tfree();
+                break;
+            case G_DESVIA_VERDADE:
+                emit_desvio(M_BNE, treg(TOPO_TEMP), R_ZERO, t.aux);
+                tfree();
+                break;
+            case G_SE_FALSO:   visita_condicao(t.no, t.aux, 0); break;
+            case G_SE_VERDADE: visita_condicao(t.no, t.aux, 1); break;
+            case G_COMPARA_FALSO:   fecha_compara(t.no, t.aux, 0); break;
+            case G_COMPARA_VERDADE: fecha_compara(t.no, t.aux, 1); break;
+            case G_LOGICO:     fecha_logico(t.no, t.aux); break;
+            case G_SALTA:  emit_j(t.aux); break;
+            case G_ROTULO: emit_rotulo(t.aux); break;
+        }
+    }
+}
+
+static void gera_comando(NoId c) {
+    empilha(G_COMANDO, c, 0);
+    executa();
+}
+
+static void gera_funcao(NoId decl) {
+    const char *nome_original = NOME(decl);
+    NoId bloco = NO_NULO, listaParam = NO_NULO;
 
-    if (decl->n_filhos > 1 && decl->filhos[1]->tipo == AST_FUNCAO) {
-        AST *func = decl->filhos[1];
-        listaParam = func->filhos[0];
-        bloco = func->filhos[1];
-    } else if (decl->n_filhos > 0 && decl->filhos[0]->tipo == AST_BLOCO) {
-        bloco = decl->filhos[0];
+    if (NFILHOS(decl) > 1 && TIPO(FILHO(decl, 1)) == AST_FUNCAO) {
+        NoId func = FILHO(decl, 1);
+        listaParam = FILHO(func, 0);
+        bloco = FILHO(func, 1);
+    } else if (NFILHOS(decl) > 0 && TIPO(FILHO(decl, 0)) == AST_BLOCO) {
+        bloco = FILHO(decl, 0);
     } else {
         fprintf(stderr, "ERRO: Declaração de função '%s' malformada.\n", nome_original);
         exit(1);
     }
-    
-    char label_func[256];
-    char rotulo_saida[32];
-    gera_nome_label_func(nome_original, label_func, sizeof(label_func));
-    novo_rotulo(rotulo_saida, sizeof(rotulo_saida));
-
-    int n_params = (listaParam) ? listaParam->n_filhos : 0;
-    AST* lista_decl_locais = (bloco && bloco->n_filhos > 0) ? bloco->filhos[0] : NULL;
-    int n_locals = (lista_decl_locais && lista_decl_locais->tipo == AST_LISTA_DECL_VAR) ? lista_decl_locais->n_filhos : 0;
-    int frame_size = (2 * WORD_SIZE) + (n_params * WORD_SIZE) + (n_locals * WORD_SIZE);
-
-    emit("\n.globl %s\n.text\n%s:\n", label_func, label_func);
-    if (strcmp(nome_original, "programa") == 0) emit("programa:\n");
-
-    emit("    addi $sp, $sp, -%d\n", frame_size);
-    emit("    sw   $ra, 0($sp)\n");
-    emit("    sw   $fp, 4($sp)\n");
-    emit("    move $fp, $sp\n");
-
-    frame_map_init();
-    if (listaParam) {
-        int off = 8;
-        for (int i = 0; i < listaParam->n_filhos; ++i) {
-            AST *param = listaParam->filhos[i];
-            const char *nomePar = param->filhos[1]->valor;
-            if (i < 4) emit("    sw   $a%d, %d($fp)\n", i, off);
-            frame_map_add(nomePar, off);
+
+    ir_limpa(&fn, nome_original, nome_original == nome_programa);
+    rotulo_saida_func = novo_rotulo();
+    fn.rotulo_min = rotulo_saida_func;
+
+    // $ra, $fp, parâmetros e locais de todos os blocos (semantico.c),
+    // os $s usados e os temporários derramados. Quantos são só se sabe
+    // depois de gerar o corpo: o addi do prólogo é corrigido no fim.
+    aloca_variaveis(decl, listaParam);
+    int base_sreg = ANOT(decl).slot;
+    int n_sreg = 0;
+    for (int r = 0; r < N_SREG; ++r)
+        if (sreg_usados & (1u << r)) ++n_sreg;
+    base_temps = base_sreg + n_sreg * WORD_SIZE;
+    maior_temp_quadro = 0;
+
+    size_t reserva = ir_instr(&fn, M_ADDI, 3, ir_reg(R_SP), ir_reg(R_SP), ir_imed(0));
+    emit_mem(M_SW, R_RA, 0, R_SP);
+    emit_mem(M_SW, R_FP, 4, R_SP);
+    emit_rr(M_MOVE, R_FP, R_SP);
+    for (int r = 0, off = base_sreg; r < N_SREG; ++r)
+        if (sreg_usados & (1u << r)) {
+            emit_mem(M_SW, R_S0 + r, off, R_FP);
             off += WORD_SIZE;
         }
+
+    if (listaParam != NO_NULO) {
+        for (int i = 0; i < NFILHOS(listaParam) && i < 4; ++i)
+            emit_acesso(M_SW, R_A0 + i, FILHO(listaParam, i));
     }
 
-    if (n_locals > 0) {
-        int off = -8;
-        for (int i = 0; i < n_locals; ++i) {
-            AST *var_decl = lista_decl_locais->filhos[i];
-            const char *nomeVar = var_decl->valor;
-            frame_map_add(nomeVar, off);
-            off -= WORD_SIZE;
+    gera_comando(bloco);
+    int frame_size = base_temps + maior_temp_quadro * WORD_SIZE;
+    fn.ins[reserva].a[2].valor = -frame_size;
+
+    emit_rotulo(rotulo_saida_func);
+    bs_str(ir_comentario(&fn), "Epílogo");
+    for (int r = 0, off = base_sreg; r < N_SREG; ++r)
+        if (sreg_usados & (1u << r)) {
+            emit_mem(M_LW, R_S0 + r, off, R_SP);
+            off += WORD_SIZE;
         }
-    }
+    emit_mem(M_LW, R_RA, 0, R_SP);
+    emit_mem(M_LW, R_FP, 4, R_SP);
+    emit_rri(M_ADDI, R_SP, R_SP, frame_size);
+    emit_r(M_JR, R_RA);
 
-    gera_comando(bloco, rotulo_saida);
+    // os passes veem a função inteira, do prólogo ao jr
+    fn.rotulo_max = rotulo_id;
+    passes_executa(&fn);
+}
 
-    emit("%s:\n", rotulo_saida);
-    emit("    # Epílogo\n");
-    emit("    lw $ra, 0($sp)\n");
-    emit("    lw $fp, 4($sp)\n");
-    emit("    addi $sp, $sp, %d\n", frame_size);
-    emit("    jr $ra\n");
+// Escreve a função gerada e marca as strings que ela usa
+static void escreve_funcao(void) {
+    for (size_t i = 0; i < fn.n; ++i)
+        for (int k = 0; k < fn.ins[i].n; ++k)
+            if (fn.ins[i].a[k].tipo == O_STR) string_usada[fn.ins[i].a[k].valor] = 1;
+    n_instrucoes += emite_funcao(&fn, out);
 }
 
 /* ------------------------------------------------------------------ */
-/* API Principal                                                      */
+/* Funções alcançáveis                                                */
 /* ------------------------------------------------------------------ */
-int gerar_codigo_mips(AST *raiz, const char *nome_s) {
-    if (!raiz) return 0;
-    out = fopen(nome_s, "w");
-    if (!out) {
-        perror(nome_s);
-        return 0;
+// Em -O2 só são geradas as funções que 'programa' pode chamar, direta
+// ou indiretamente: busca no grafo de chamadas a partir dele (a
+// chamada já aponta para o nó da declaração, ANOT.slot), sem entrar
+// nos ramos que não serão gerados.
+static uint8_t *alcancada = NULL;   // por nó AST_DECL_FUNCAO
+static NoId *pendentes = NULL;      // nós ainda a percorrer
+static size_t n_pendentes = 0, cap_pendentes = 0;
+
+static void pendente(NoId n) {
+    if (n_pendentes == cap_pendentes)
+        pendentes = cresce_pilha(pendentes, &cap_pendentes, sizeof *pendentes);
+    pendentes[n_pendentes++] = n;
+}
+
+static void marca_alcancaveis(NoId programa) {
+    alcancada = calloc(arv->n_nos, 1);
+    if (!alcancada) sem_memoria();
+    alcancada[programa] = 1;
+    pendente(programa);
+    while (n_pendentes) {
+        NoId n = pendentes[--n_pendentes];
+        if (TIPO(n) == AST_CHAMADA_FUNCAO && !alcancada[ANOT(n).slot]) {
+            alcancada[ANOT(n).slot] = 1;
+            pendente((NoId)ANOT(n).slot);
+        }
+        for (int k = 0; k < NFILHOS(n); ++k)
+            if (!filho_morto(n, k)) pendente(FILHO(n, k));
     }
-    
-    coleta_strings_pass(raiz);
-    
-    gera_secao_data(raiz);
-    
-    emit("\n.text\n");
-    
-    if (raiz->n_filhos > 0 && raiz->filhos[0]) {
-        AST* lista_decl = raiz->filhos[0];
-        for (int i = 0; i < lista_decl->n_filhos; ++i) {
-            if (lista_decl->filhos[i]->tipo == AST_DECL_FUNCAO) {
-                gera_funcao(lista_decl->filhos[i]);
-            }
+    free(pendentes);
+    pendentes = NULL;
+    cap_pendentes = 0;
+}
+
+// Bytes de assembly que as funções omitidas teriam, para o
+// -ftime-report: são geradas à parte, depois da saída pronta (os
+// rótulos da saída não mudam), com a medição suspensa
+static long mede_omitidas(NoId lista_decl) {
+    BufferSaida descarte;
+    long bytes = 0;
+    bs_abre_memoria(&descarte);
+    est_suspende(1);
+    for (int i = 0; i < NFILHOS(lista_decl); ++i) {
+        NoId d = FILHO(lista_decl, i);
+        if (TIPO(d) != AST_DECL_FUNCAO || alcancada[d]) continue;
+        gera_funcao(d);
+        descarte.tam = 0;
+        emite_funcao(&fn, &descarte);
+        bytes += (long)descarte.tam;
+    }
+    est_suspende(0);
+    bs_libera(&descarte);
+    return bytes;
+}
+
+/* ------------------------------------------------------------------ */
+/* API Principal                                                      */
+/* ------------------------------------------------------------------ */
+int gerar_codigo_mips_buffer(const ASTC *a, BufferSaida *saida) {
+    if (!a || !a->n_nos || !a->anot) return 0;  // exige analise_semanica()
+    arv = a;
+    out = saida;
+    NoId raiz = 0;
+
+    nome_programa = intern_str("programa");
+    n_instrucoes = 0;
+    n_derramados = n_recargas = n_salvos = n_invertidos = 0;
+    n_mul_reduzidas = n_div_reduzidas = n_ramos_constantes = 0;
+    poda_ramos = passes_nivel_atual() >= 2;
+    n_vars_reg = n_vars_memoria = n_acessos_memoria = 0;
+    string_id_counter = 0;
+    ir_inicia(&fn);
+    est_entra(FASE_STRINGS);
+    coleta_strings_pass();
+    est_conta(FASE_STRINGS, string_id_counter);
+    est_sai(FASE_STRINGS);
+    string_usada = calloc(string_id_counter + 1, 1);
+    if (!string_usada) sem_memoria();
+    n_strings_omitidas = 0;
+
+    calcula_custos();
+
+    NoId lista_decl = NFILHOS(raiz) > 0 ? FILHO(raiz, 0) : NO_NULO;
+    if (poda_ramos && NFILHOS(raiz) > 1) marca_alcancaveis(FILHO(raiz, 1));
+    n_funcoes_omitidas = 0;
+    for (int i = 0; lista_decl != NO_NULO && i < NFILHOS(lista_decl); ++i) {
+        NoId d = FILHO(lista_decl, i);
+        if (TIPO(d) != AST_DECL_FUNCAO) continue;
+        if (alcancada && !alcancada[d]) {
+            ++n_funcoes_omitidas;
+            continue;
         }
+        gera_funcao(d);
+        escreve_funcao();
     }
-    if (raiz->n_filhos > 1 && raiz->filhos[1]) {
-        gera_funcao(raiz->filhos[1]);
+    if (NFILHOS(raiz) > 1) {
+        gera_funcao(FILHO(raiz, 1));
+        escreve_funcao();
     }
-    
+
+    gera_secao_data(raiz);
+    est_conta(FASE_CODIGO, n_instrucoes);
+
+    est_contador("codigo.temporarios_derramados", n_derramados);
+    est_contador("codigo.temporarios_salvos_em_chamadas", n_salvos);
+    est_contador("codigo.temporarios_recarregados", n_recargas);
+    est_contador("codigo.avaliacoes_reordenadas", n_invertidos);
+    est_contador("codigo.variaveis_em_registradores", n_vars_reg);
+    est_contador("codigo.variaveis_no_quadro", n_vars_memoria);
+    est_contador("codigo.acessos_memoria", n_acessos_memoria);
+    est_contador("codigo.multiplicacoes_reduzidas", n_mul_reduzidas);
+    est_contador("codigo.divisoes_reduzidas", n_div_reduzidas);
+    est_contador("codigo.ramos_constantes", n_ramos_constantes);
+    est_contador("codigo.strings_omitidas", n_strings_omitidas);
+    est_contador("codigo.funcoes_omitidas", n_funcoes_omitidas);
+    if (n_funcoes_omitidas > 0 && est_ativo())
+        est_contador("codigo.bytes_omitidos", mede_omitidas(lista_decl));
+
+    free(tarefas);
+    free(string_usada);
+    string_usada = NULL;
+    free(alcancada);
+    alcancada = NULL;
+    free(temps);
+    free(custos);
+    free(reg_var);
+    free(intervalos);
+    free(lacos);
+    free(abertos);
+    custos = NULL;
+    reg_var = NULL;
+    intervalos = NULL;
+    lacos = NULL;
+    abertos = NULL;
+    cap_var = n_lacos = cap_lacos = cap_abertos = 0;
+    ir_libera(&fn);
+    tarefas = NULL;
+    temps = NULL;
+    n_tarefas = cap_tarefas = n_temps = cap_temps = 0;
+
     while (lista_strings) {
         StringLiteral* temp = lista_strings;
         lista_strings = lista_strings->next;
-        free(temp->valor);
         free(temp);
     }
-    
-    fclose(out);
+    out = NULL;
     return 1;
 }
+
+int gerar_codigo_mips(const ASTC *raiz, const char *nome_s) {
+    if (!raiz) return 0;
+    BufferSaida saida;
+    if (strcmp(nome_s, "-") == 0) {
+        bs_abre_fd(&saida, 1);
+    } else if (!bs_abre_arquivo(&saida, nome_s)) {
+        return 0;
+    }
+    int ok = gerar_codigo_mips_buffer(raiz, &saida);
+    if (!bs_fecha(&saida)) {
+        perror(nome_s);
+        ok = 0;
+    }
+    return ok;
+}
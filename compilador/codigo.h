@@ -5,7 +5,12 @@
 #define CODIGO_H
 
 #include "ast.h"
+#include "buffer_saida.h"
 
-int gerar_codigo_mips(AST *raiz, const char *nome_asm);
+/* Grava em 'nome_asm' ("-" = saída padrão); arv já passou pela
+ * análise semântica (usa as anotações em arv->anot) */
+int gerar_codigo_mips(const ASTC *arv, const char *nome_asm);
+/* Gera no buffer dado (arquivo, stdout ou memória); não o fecha */
+int gerar_codigo_mips_buffer(const ASTC *arv, BufferSaida *saida);
 
 #endif /* CODIGO_H */
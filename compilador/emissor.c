@@ -0,0 +1,104 @@
+/* =====================================================================
+ * emissor.c  ─  Texto MIPS a partir da representação intermediária
+ * ===================================================================== */
+// Cada instrução é escrita operando a operando direto no buffer de
+// saída, sem formatação printf: "    op a, b, c".
+#include "emissor.h"
+#include "intern.h"
+#include <string.h>
+
+// Rótulos: L<n> (internos), str<n> (strings), var_<nome> (globais) e
+// user_<nome> / main (funções)
+void emite_rotulo_var(BufferSaida *saida, const char *nome) {
+    bs_bytes(saida, "var_", 4);
+    bs_bytes(saida, nome, intern_tamanho(nome));
+}
+
+void emite_rotulo_func(BufferSaida *saida, const char *nome) {
+    if (nome == intern_str("programa")) {
+        bs_bytes(saida, "main", 4);
+    } else {
+        bs_bytes(saida, "user_", 5);
+        bs_bytes(saida, nome, intern_tamanho(nome));
+    }
+}
+
+static void emite_operando(const FuncaoIR *f, const Operando *o, BufferSaida *saida) {
+    switch ((TipoOperando)o->tipo) {
+        case O_REG:
+            bs_str(saida, IR_NOME_REG[o->reg]);
+            break;
+        case O_IMED:
+            bs_int(saida, o->valor);
+            break;
+        case O_ROTULO:
+            bs_char(saida, 'L');
+            bs_int(saida, o->valor);
+            break;
+        case O_MEM:
+            bs_int(saida, o->valor);
+            bs_char(saida, '(');
+            bs_str(saida, IR_NOME_REG[o->reg]);
+            bs_char(saida, ')');
+            break;
+        case O_VAR:
+            emite_rotulo_var(saida, o->nome);
+            break;
+        case O_FUNC:
+            emite_rotulo_func(saida, o->nome);
+            break;
+        case O_STR:
+            bs_bytes(saida, "str", 3);
+            bs_int(saida, o->valor);
+            break;
+        case O_SIMBOLO:
+            bs_str(saida, o->nome);
+            break;
+        case O_TEXTO: {
+            const char *t = f->textos.dados + o->valor;
+            size_t n = f->textos.tam - (size_t)o->valor;
+            const char *fim = memchr(t, '\0', n);
+            bs_bytes(saida, t, fim ? (size_t)(fim - t) : n);
+            break;
+        }
+        case O_NADA:
+            break;
+    }
+}
+
+long emite_funcao(const FuncaoIR *f, BufferSaida *saida) {
+    long n_instrucoes = 0;
+    bs_str(saida, "\n.globl ");
+    emite_rotulo_func(saida, f->nome);
+    bs_str(saida, "\n.text\n");
+    emite_rotulo_func(saida, f->nome);
+    bs_str(saida, ":\n");
+    if (f->eh_programa) bs_str(saida, "programa:\n");
+
+    for (size_t i = 0; i < f->n; ++i) {
+        const Instr *in = &f->ins[i];
+        switch (in->op) {
+            case M_NENHUM:
+                continue;
+            case M_ROTULO:
+                emite_operando(f, &in->a[0], saida);
+                bs_bytes(saida, ":\n", 2);
+                continue;
+            case M_COMENTARIO:
+                bs_bytes(saida, "    # ", 6);
+                emite_operando(f, &in->a[0], saida);
+                bs_char(saida, '\n');
+                continue;
+        }
+        ++n_instrucoes;
+        bs_bytes(saida, "    ", 4);
+        bs_str(saida, ir_nome((Mnemonico)in->op));
+        for (int k = 0; k < in->n; ++k) {
+            if (k) bs_bytes(saida, ", ", 2);
+            else bs_char(saida, ' ');
+            emite_operando(f, &in->a[k], saida);
+        }
+        bs_char(saida, '\n');
+    }
+    return n_instrucoes;
+}
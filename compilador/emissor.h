@@ -0,0 +1,20 @@
+/* ------------------------------------------------------------------
+ * emissor.h  –  Escrita do assembly MIPS (sintaxe do SPIM) a partir
+ *               da representação intermediária de uma função
+ * ------------------------------------------------------------------ */
+#ifndef EMISSOR_H
+#define EMISSOR_H
+
+#include "ir.h"
+#include "buffer_saida.h"
+
+/* Escreve o cabeçalho (.globl, .text e o rótulo da função, mais
+ * "programa:" no programa principal) e as instruções de f. Devolve
+ * quantas instruções foram escritas (sem rótulos e comentários). */
+long emite_funcao(const FuncaoIR *f, BufferSaida *saida);
+
+/* Rótulos de globais e funções, também usados na seção .data */
+void emite_rotulo_var(BufferSaida *saida, const char *nome);
+void emite_rotulo_func(BufferSaida *saida, const char *nome);
+
+#endif /* EMISSOR_H */
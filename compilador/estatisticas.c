@@ -0,0 +1,277 @@
+#include "estatisticas.h"
+#include <malloc.h>
+#include <string.h>
+#include <sys/resource.h>
+#include <time.h>
+
+typedef struct Medida {
+    double parede, cpu;      /* segundos, só da própria fase            */
+    long   heap;             /* saldo de bytes em uso no heap           */
+    long   pico_rss;         /* KiB; pico do processo ao fim da fase    */
+    long   itens;
+    long   entradas;
+} Medida;
+
+static const struct { const char *nome, *chave, *unidade; } INFO[N_FASES] = {
+    [FASE_LEXICO]    = { "léxico",    "lexico",    "tokens"     },
+    [FASE_SINTATICO] = { "sintático", "sintatico", "nós"        },
+    [FASE_SEMANTICO] = { "semântico", "semantico", "nós"        },
+    [FASE_OTIMIZACAO] = { "otimização", "otimizacao", "nós"       },
+    [FASE_STRINGS]   = { "strings",   "strings",   "strings"    },
+    [FASE_CODIGO]    = { "código",    "codigo",    "instruções" },
+    [FASE_PASSES]    = { "passes",    "passes",    "mudanças"   },
+    [FASE_SAIDA]     = { "saída",     "saida",     "bytes"      },
+};
+
+/* fases que entram e saem muitas vezes: só tempo de parede (relógio
+ * do vDSO, sem chamada ao sistema); CPU e memória ficam com a fase de
+ * baixo */
+#define LEVE(f) ((f) == FASE_LEXICO || (f) == FASE_PASSES)
+
+#define MAX_PILHA 16
+#define MAX_CONTADORES 64
+#define MAX_PASSOS 16
+
+static int    ativo = 0;
+static Medida med[N_FASES];
+static long   linhas = 0;
+static double inicio_parede, inicio_cpu;
+
+/* marcas de quando cada fase da pilha foi (re)iniciada */
+static struct { Fase f; double parede, cpu; long heap; } pilha[MAX_PILHA];
+static int topo = 0;
+
+static struct { const char *nome; long valor; } contadores[MAX_CONTADORES];
+static int n_contadores = 0;
+
+static struct { const char *nome; double parede; long execucoes, mudancas; } passos[MAX_PASSOS];
+static int n_passos = 0;
+
+static double relogio(clockid_t c) {
+    struct timespec t;
+    clock_gettime(c, &t);
+    return t.tv_sec + t.tv_nsec * 1e-9;
+}
+
+static long heap_em_uso(void) {
+    struct mallinfo2 m = mallinfo2();
+    return (long)(m.uordblks + m.hblkhd);
+}
+
+static long pico_rss(void) {
+    struct rusage r;
+    getrusage(RUSAGE_SELF, &r);
+    return r.ru_maxrss;
+}
+
+void est_ativa(void) {
+    memset(med, 0, sizeof med);
+    topo = 0;
+    n_contadores = 0;
+    n_passos = 0;
+    ativo = 1;
+    inicio_parede = relogio(CLOCK_MONOTONIC);
+    inicio_cpu = relogio(CLOCK_PROCESS_CPUTIME_ID);
+}
+
+int est_ativo(void) {
+    return ativo;
+}
+
+void est_suspende(int suspende) {
+    static int suspenso = 0;
+    if (suspende && ativo) {
+        ativo = 0;
+        suspenso = 1;
+    } else if (!suspende && suspenso) {
+        ativo = 1;
+        suspenso = 0;
+    }
+}
+
+// Fecha o trecho corrente do topo da pilha (até o instante dado);
+// 'completo' é 0 quando a troca envolve uma fase leve
+static void acumula_topo(double parede, double cpu, long heap, int completo) {
+    Medida *m = &med[pilha[topo - 1].f];
+    m->parede += parede - pilha[topo - 1].parede;
+    if (!completo) return;
+    m->cpu += cpu - pilha[topo - 1].cpu;
+    m->heap += heap - pilha[topo - 1].heap;
+}
+
+void est_entra(Fase f) {
+    if (!ativo || topo == MAX_PILHA) return;
+    double parede = relogio(CLOCK_MONOTONIC);
+    double cpu = LEVE(f) ? 0 : relogio(CLOCK_PROCESS_CPUTIME_ID);
+    long heap = LEVE(f) ? 0 : heap_em_uso();
+    if (topo > 0) acumula_topo(parede, cpu, heap, !LEVE(f));
+
+    pilha[topo].f = f;
+    pilha[topo].parede = parede;
+    pilha[topo].cpu = cpu;
+    pilha[topo].heap = heap;
+    ++topo;
+    med[f].entradas++;
+}
+
+void est_sai(Fase f) {
+    if (!ativo || topo == 0 || pilha[topo - 1].f != f) return;
+    double parede = relogio(CLOCK_MONOTONIC);
+    double cpu = LEVE(f) ? 0 : relogio(CLOCK_PROCESS_CPUTIME_ID);
+    long heap = LEVE(f) ? 0 : heap_em_uso();
+    acumula_topo(parede, cpu, heap, !LEVE(f));
+    if (!LEVE(f)) med[f].pico_rss = pico_rss();
+    --topo;
+
+    /* retoma a fase de baixo; depois de uma fase leve as marcas de CPU
+     * e heap dela continuam valendo */
+    if (topo > 0) {
+        pilha[topo - 1].parede = parede;
+        if (!LEVE(f)) {
+            pilha[topo - 1].cpu = cpu;
+            pilha[topo - 1].heap = heap;
+        }
+    }
+}
+
+void est_conta(Fase f, long n) {
+    if (ativo) med[f].itens += n;
+}
+
+void est_linhas(long n) {
+    linhas = n;
+}
+
+void est_contador(const char *nome, long n) {
+    if (!ativo) return;
+    int i = 0;
+    while (i < n_contadores && strcmp(contadores[i].nome, nome) != 0) ++i;
+    if (i == n_contadores) {
+        if (n_contadores == MAX_CONTADORES) return;
+        contadores[n_contadores].nome = nome;
+        contadores[n_contadores++].valor = 0;
+    }
+    contadores[i].valor += n;
+}
+
+double est_relogio(void) {
+    return ativo ? relogio(CLOCK_MONOTONIC) : 0;
+}
+
+void est_passo(const char *nome, double segundos, long mudancas) {
+    if (!ativo) return;
+    int i = 0;
+    while (i < n_passos && strcmp(passos[i].nome, nome) != 0) ++i;
+    if (i == n_passos) {
+        if (n_passos == MAX_PASSOS) return;
+        memset(&passos[n_passos++], 0, sizeof passos[0]);
+        passos[i].nome = nome;
+    }
+    passos[i].parede += segundos;
+    passos[i].execucoes++;
+    passos[i].mudancas += mudancas;
+}
+
+/* ------------------------------------------------------------------ */
+/* Relatórios                                                         */
+/* ------------------------------------------------------------------ */
+
+// Escreve s alinhado à esquerda em 'largura' colunas (conta caracteres
+// UTF-8, não bytes, para os nomes acentuados)
+static void coluna(FILE *f, const char *s, int largura) {
+    int n = 0;
+    for (const char *p = s; *p; ++p)
+        if ((*p & 0xC0) != 0x80) ++n;
+    fputs(s, f);
+    for (; n < largura; ++n) fputc(' ', f);
+}
+
+void est_relatorio(FILE *f) {
+    if (!ativo) return;
+    double parede = relogio(CLOCK_MONOTONIC) - inicio_parede;
+    double cpu = relogio(CLOCK_PROCESS_CPUTIME_ID) - inicio_cpu;
+    long heap = 0;
+
+    fprintf(f, "\n---------------- tempo por fase ----------------\n");
+    fprintf(f, "fase        parede(ms)   cpu(ms)      %%  heap(KiB)  pico RSS(KiB)  itens\n");
+    for (int i = 0; i < N_FASES; ++i) {
+        const Medida *m = &med[i];
+        coluna(f, INFO[i].nome, 10);
+        fprintf(f, "%12.3f", m->parede * 1e3);
+        if (LEVE(i)) fprintf(f, " %9s", "-");
+        else fprintf(f, " %9.3f", m->cpu * 1e3);
+        fprintf(f, " %6.1f", parede > 0 ? 100.0 * m->parede / parede : 0.0);
+        if (LEVE(i)) fprintf(f, " %10s %14s", "-", "-");
+        else fprintf(f, " %10.1f %14ld", m->heap / 1024.0, m->pico_rss);
+        fprintf(f, "  %ld %s\n", m->itens, INFO[i].unidade);
+        heap += m->heap;
+    }
+    fprintf(f, "total     %12.3f %9.3f %6.1f %10.1f %14ld\n",
+            parede * 1e3, cpu * 1e3, 100.0, heap / 1024.0, pico_rss());
+    if (linhas > 0 && parede > 0)
+        fprintf(f, "%ld linhas, %.0f linhas/s\n", linhas, linhas / parede);
+    if (n_passos > 0) {
+        fprintf(f, "\n---------------- passes ----------------\n");
+        fprintf(f, "passe                   parede(ms)  execuções   mudanças\n");
+        for (int i = 0; i < n_passos; ++i) {
+            coluna(f, passos[i].nome, 20);
+            fprintf(f, "%14.3f %10ld %10ld\n", passos[i].parede * 1e3,
+                    passos[i].execucoes, passos[i].mudancas);
+        }
+    }
+    if (n_contadores > 0) {
+        fprintf(f, "\n---------------- contadores ----------------\n");
+        for (int i = 0; i < n_contadores; ++i)
+            fprintf(f, "%-36s %12ld\n", contadores[i].nome, contadores[i].valor);
+    }
+}
+
+static void json_texto(FILE *f, const char *s) {
+    fputc('"', f);
+    for (; *s; ++s) {
+        unsigned char c = (unsigned char)*s;
+        if (c == '"' || c == '\\') fprintf(f, "\\%c", c);
+        else if (c < 0x20) fprintf(f, "\\u%04x", c);
+        else fputc(c, f);
+    }
+    fputc('"', f);
+}
+
+void est_relatorio_json(FILE *f, const char *fonte) {
+    if (!ativo) return;
+    double parede = relogio(CLOCK_MONOTONIC) - inicio_parede;
+    double cpu = relogio(CLOCK_PROCESS_CPUTIME_ID) - inicio_cpu;
+    long heap = 0;
+
+    fprintf(f, "{\n  \"fonte\": ");
+    json_texto(f, fonte ? fonte : "");
+    fprintf(f, ",\n  \"linhas\": %ld,\n  \"fases\": [\n", linhas);
+    for (int i = 0; i < N_FASES; ++i) {
+        const Medida *m = &med[i];
+        fprintf(f, "    {\"fase\": \"%s\", \"parede_ms\": %.3f, ",
+                INFO[i].chave, m->parede * 1e3);
+        if (LEVE(i))
+            fprintf(f, "\"cpu_ms\": null, \"heap_bytes\": null, \"pico_rss_kib\": null, ");
+        else
+            fprintf(f, "\"cpu_ms\": %.3f, \"heap_bytes\": %ld, \"pico_rss_kib\": %ld, ",
+                    m->cpu * 1e3, m->heap, m->pico_rss);
+        fprintf(f, "\"entradas\": %ld, \"itens\": %ld, \"unidade\": \"%s\"}%s\n",
+                m->entradas, m->itens, INFO[i].unidade, i + 1 < N_FASES ? "," : "");
+        heap += m->heap;
+    }
+    fprintf(f, "  ],\n  \"passes\": [");
+    for (int i = 0; i < n_passos; ++i)
+        fprintf(f, "%s\n    {\"passe\": \"%s\", \"parede_ms\": %.3f, "
+                   "\"execucoes\": %ld, \"mudancas\": %ld}",
+                i ? "," : "", passos[i].nome, passos[i].parede * 1e3,
+                passos[i].execucoes, passos[i].mudancas);
+    fprintf(f, "%s],\n  \"contadores\": {", n_passos ? "\n  " : "");
+    for (int i = 0; i < n_contadores; ++i) {
+        fprintf(f, "%s\n    ", i ? "," : "");
+        json_texto(f, contadores[i].nome);
+        fprintf(f, ": %ld", contadores[i].valor);
+    }
+    fprintf(f, "%s},\n  \"total\": {\"parede_ms\": %.3f, \"cpu_ms\": %.3f, "
+               "\"heap_bytes\": %ld, \"pico_rss_kib\": %ld}\n}\n",
+            n_contadores ? "\n  " : "", parede * 1e3, cpu * 1e3, heap, pico_rss());
+}
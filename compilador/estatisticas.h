@@ -0,0 +1,60 @@
+/* ------------------------------------------------------------------
+ * estatisticas.h  –  Medição do compilador por fase (tempo de parede
+ *                    e de CPU, memória, contagens), no estilo do
+ *                    -ftime-report do gcc
+ * ------------------------------------------------------------------ */
+#ifndef ESTATISTICAS_H
+#define ESTATISTICAS_H
+
+#include <stdio.h>
+
+typedef enum {
+    FASE_LEXICO,         /* yylex (medido de dentro do parser)      */
+    FASE_SINTATICO,      /* yyparse + achatamento da AST            */
+    FASE_SEMANTICO,
+    FASE_OTIMIZACAO,     /* dobramento de constantes e identidades  */
+    FASE_STRINGS,        /* coleta das strings literais             */
+    FASE_CODIGO,
+    FASE_PASSES,         /* passes sobre a IR de cada função        */
+    FASE_SAIDA,          /* write(2) do buffer de saída             */
+    N_FASES
+} Fase;
+
+/* Enquanto est_ativa() não for chamada, todas as funções abaixo
+ * retornam sem fazer nada (custo: um teste de flag). */
+void est_ativa(void);
+int  est_ativo(void);
+
+/* As fases formam uma pilha: est_entra pausa a fase corrente e
+ * est_sai a retoma, então cada fase mede só o próprio tempo.
+ * FASE_LEXICO, que entra uma vez por token, mede só o tempo de
+ * parede; CPU e memória do scanner ficam com a fase sintática. */
+void est_entra(Fase f);
+void est_sai(Fase f);
+
+/* Suspende (1) e retoma (0) a medição, para trabalho que não é parte
+ * da compilação: enquanto suspensa, tudo aqui é ignorado */
+void est_suspende(int suspende);
+
+/* Itens processados pela fase (tokens, nós, instruções, bytes...) */
+void est_conta(Fase f, long n);
+/* Linhas do fonte, para o total */
+void est_linhas(long n);
+
+/* Contadores nomeados de uma fase (ex.: "codigo.derramamentos"),
+ * somados por nome e listados no fim dos relatórios. O nome deve ser
+ * uma constante (só o ponteiro é guardado). */
+void est_contador(const char *nome, long n);
+
+/* Passes sobre a IR (passes.c): tempo de parede e mudanças de cada
+ * execução, somados por nome (constante, como nos contadores).
+ * est_relogio dá o instante em segundos, 0 se a medição está
+ * desligada. */
+double est_relogio(void);
+void est_passo(const char *nome, double segundos, long mudancas);
+
+/* Relatório legível (tabela) e JSON */
+void est_relatorio(FILE *f);
+void est_relatorio_json(FILE *f, const char *fonte);
+
+#endif /* ESTATISTICAS_H */
@@ -0,0 +1,108 @@
+#include "fonte.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/* Interface do scanner gerado pelo Flex (lex.yy.c) */
+typedef struct yy_buffer_state *YY_BUFFER_STATE;
+YY_BUFFER_STATE yy_scan_buffer(char *base, size_t size);
+void yy_delete_buffer(YY_BUFFER_STATE b);
+
+/* yy_scan_buffer exige que o buffer termine com dois bytes '\0' e escreve
+ * no buffer durante a varredura (troca temporária do caractere depois do
+ * lexema). Por isso:
+ *  - reservamos tamanho+2 bytes (arredondado para páginas) com um
+ *    mapeamento anônimo, que vem zerado;
+ *  - mapeamos o arquivo por cima, MAP_PRIVATE|MAP_FIXED, com escrita:
+ *    o resto da última página do arquivo já é zero, e se o arquivo
+ *    termina exatamente numa fronteira de página os dois zeros vêm da
+ *    página anônima seguinte. As escritas do Flex ficam no processo.
+ * Retorna 0 se não deu para mapear (o chamador lê com read). */
+static int mapeia(Fonte *f, int fd, size_t tamanho) {
+    size_t pagina = (size_t)sysconf(_SC_PAGESIZE);
+    size_t mapeado = (tamanho + 2 + pagina - 1) & ~(pagina - 1);
+
+    char *base = mmap(NULL, mapeado, PROT_READ | PROT_WRITE,
+                      MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (base == MAP_FAILED) return 0;
+    if (tamanho > 0 &&
+        mmap(base, tamanho, PROT_READ | PROT_WRITE,
+             MAP_PRIVATE | MAP_FIXED, fd, 0) == MAP_FAILED) {
+        munmap(base, mapeado);
+        return 0;
+    }
+    f->base = base;
+    f->tamanho = tamanho;
+    f->mapeado = mapeado;
+    return 1;
+}
+
+/* Pipes, /dev/stdin, <(...) e afins não têm tamanho no fstat nem podem
+ * ser mapeados: a entrada inteira é lida num buffer com malloc, com os
+ * dois '\0' no fim (mapeado == 0 marca esse caso). */
+static int le_tudo(Fonte *f, int fd) {
+    size_t cap = 1 << 16, tam = 0;
+    char *buf = malloc(cap);
+    if (!buf) return 0;
+    for (;;) {
+        if (cap - tam <= 2) {   /* read de 0 bytes pareceria fim de arquivo */
+            char *novo = realloc(buf, cap * 2);
+            if (!novo) { free(buf); return 0; }
+            buf = novo;
+            cap *= 2;
+        }
+        ssize_t n = read(fd, buf + tam, cap - tam - 2);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            free(buf);
+            return 0;
+        }
+        if (n == 0) break;
+        tam += (size_t)n;
+    }
+    buf[tam] = buf[tam + 1] = '\0';
+    f->base = buf;
+    f->tamanho = tam;
+    f->mapeado = 0;
+    return 1;
+}
+
+int fonte_abre(Fonte *f, const char *caminho) {
+    f->base = NULL;
+    f->buffer = NULL;
+
+    int fd = open(caminho, O_RDONLY);
+    if (fd < 0) {
+        perror("falha abrindo arquivo");
+        return 0;
+    }
+    struct stat st;
+    if (fstat(fd, &st) < 0) {
+        perror("falha abrindo arquivo");
+        close(fd);
+        return 0;
+    }
+
+    int ok = S_ISREG(st.st_mode) && mapeia(f, fd, (size_t)st.st_size);
+    if (!ok && !le_tudo(f, fd)) {
+        perror("falha lendo arquivo");
+        close(fd);
+        return 0;
+    }
+    close(fd);   /* o mapeamento continua válido */
+
+    f->buffer = yy_scan_buffer(f->base, f->tamanho + 2);
+    return 1;
+}
+
+void fonte_fecha(Fonte *f) {
+    if (f->buffer) yy_delete_buffer((YY_BUFFER_STATE)f->buffer);
+    if (f->base && f->mapeado) munmap(f->base, f->mapeado);
+    else free(f->base);
+    f->buffer = NULL;
+    f->base = NULL;
+}
@@ -0,0 +1,24 @@
+/* ------------------------------------------------------------------
+ * fonte.h  –  Entrada do arquivo-fonte via mmap, entregue ao Flex
+ *             sem cópia (yy_scan_buffer sobre o próprio mapeamento);
+ *             o que não é arquivo comum é lido num buffer
+ * ------------------------------------------------------------------ */
+#ifndef FONTE_H
+#define FONTE_H
+
+#include <stddef.h>
+
+typedef struct Fonte {
+    char   *base;        /* início do mapeamento (ou do buffer)     */
+    size_t  tamanho;     /* bytes do arquivo                        */
+    size_t  mapeado;     /* bytes reservados (tamanho + 2, arred.); */
+                         /* 0: base veio de malloc                  */
+    void   *buffer;      /* YY_BUFFER_STATE do Flex                 */
+} Fonte;
+
+/* Mapeia 'caminho' (ou o lê, se não for arquivo comum) e o instala como buffer corrente do scanner.
+ * Retorna 1 em caso de sucesso; em erro imprime a causa e retorna 0. */
+int  fonte_abre(Fonte *f, const char *caminho);
+void fonte_fecha(Fonte *f);
+
+#endif /* FONTE_H */
@@ -1,8 +1,8 @@
-/* A Bison parser, made by GNU Bison 3.5.1.  */
+/* A Bison parser, made by GNU Bison 3.8.2.  */
 
 /* Bison implementation for Yacc-like parsers in C
 
-   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2020 Free Software Foundation,
+   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2021 Free Software Foundation,
    Inc.
 
    This program is free software: you can redistribute it and/or modify
@@ -16,7 +16,7 @@
    GNU General Public License for more details.
 
    You should have received a copy of the GNU General Public License
-   along with this program.  If not, see <http://www.gnu.org/licenses/>.  */
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
 
 /* As a special exception, you may create a larger work that contains
    part or all of the Bison parser skeleton and distribute that work
@@ -34,6 +34,10 @@
 /* C LALR(1) parser skeleton written by Richard Stallman, by
    simplifying the original so-called "semantic" parser.  */
 
+/* DO NOT RELY ON FEATURES THAT ARE NOT DOCUMENTED in the manual,
+   especially those whose name start with YY_ or yy_.  They are
+   private implementation details that can be changed or removed.  */
+
 /* All symbols defined below should begin with yy or YY, to avoid
    infringing on user name space.  This should be done even for local
    variables, as they might otherwise be expanded by user macros.
@@ -41,14 +45,11 @@
    define necessary library symbols; they are noted "INFRINGES ON
    USER NAME SPACE" below.  */
 
-/* Undocumented macros, especially those whose name start with YY_,
-   are private implementation details.  Do not rely on them.  */
-
-/* Identify Bison output.  */
-#define YYBISON 1
+/* Identify Bison output, and Bison version.  */
+#define YYBISON 30802
 
-/* Bison version.  */
-#define YYBISON_VERSION "3.5.1"
+/* Bison version string.  */
+#define YYBISON_VERSION "3.8.2"
 
 /* Skeleton name.  */
 #define YYSKELETON_NAME "yacc.c"
@@ -68,21 +69,48 @@
 /* First part of user prologue.  */
 #line 5 "goianinha.y"
 
+    #include <errno.h>
+    #include <stdint.h>
     #include <stdio.h>
     #include <stdlib.h>
     #include "ast.h"
+    #include "intern.h"
+    #include "estatisticas.h"
+
+    /* a pilha do parser cresce no heap (dobrando) até este limite;
+       o padrão do Bison (10000) não comporta aninhamentos profundos */
+    #define YYMAXDEPTH 50000000
 
     extern int yylineno;        /* linha atual do Flex */
     int yylex(void);
     void yyerror(const char *s);
 
+    /* com -ftime-report, conta os tokens e mede o tempo do scanner */
+    static int yylex_medido(void) {
+        if (!est_ativo()) return yylex();
+        est_entra(FASE_LEXICO);
+        int t = yylex();
+        est_sai(FASE_LEXICO);
+        est_conta(FASE_LEXICO, 1);
+        return t;
+    }
+    #define yylex yylex_medido
+
     AST *arvore_raiz = NULL;    /* raiz global da AST */
 
     void yyerror(const char *s) {
         fprintf(stderr, "ERRO: %s linha %d\n", s, yylineno);
     }
 
-#line 86 "goianinha.tab.c"
+    /* int é de 32 bits com sinal: um literal maior que INT32_MAX não
+       tem representação (-2147483648 se escreve -2147483647 - 1) */
+    static int inteiro_cabe(const char *texto) {
+        errno = 0;
+        unsigned long v = strtoul(texto, NULL, 10);
+        return errno == 0 && v <= INT32_MAX;
+    }
+
+#line 114 "goianinha.tab.c"
 
 # ifndef YY_CAST
 #  ifdef __cplusplus
@@ -105,96 +133,78 @@
 #  endif
 # endif
 
-/* Enabling verbose error messages.  */
-#ifdef YYERROR_VERBOSE
-# undef YYERROR_VERBOSE
-# define YYERROR_VERBOSE 1
-#else
-# define YYERROR_VERBOSE 0
-#endif
-
-/* Use api.header.include to #include this header
-   instead of duplicating it here.  */
-#ifndef YY_YY_GOIANINHA_TAB_H_INCLUDED
-# define YY_YY_GOIANINHA_TAB_H_INCLUDED
-/* Debug traces.  */
-#ifndef YYDEBUG
-# define YYDEBUG 0
-#endif
-#if YYDEBUG
-extern int yydebug;
-#endif
-
-/* Token type.  */
-#ifndef YYTOKENTYPE
-# define YYTOKENTYPE
-  enum yytokentype
-  {
-    PROGRAMA = 258,
-    INT = 259,
-    CAR = 260,
-    RETORNE = 261,
-    LEIA = 262,
-    ESCREVA = 263,
-    NOVALINHA = 264,
-    SE = 265,
-    ENTAO = 266,
-    SENAO = 267,
-    ENQUANTO = 268,
-    EXECUTE = 269,
-    OU = 270,
-    E = 271,
-    EQ = 272,
-    NEQ = 273,
-    LEQ = 274,
-    GEQ = 275,
-    ID = 276,
-    INTCONST = 277,
-    CARCONST = 278,
-    STRING = 279,
-    UMINUS = 280
-  };
-#endif
-
-/* Value type.  */
-#if ! defined YYSTYPE && ! defined YYSTYPE_IS_DECLARED
-union YYSTYPE
-{
-#line 22 "goianinha.y"
-
-    int   ival;
-    char *sval;
-    AST  *ast;
-
-#line 170 "goianinha.tab.c"
-
-};
-typedef union YYSTYPE YYSTYPE;
-# define YYSTYPE_IS_TRIVIAL 1
-# define YYSTYPE_IS_DECLARED 1
-#endif
-
-/* Location type.  */
-#if ! defined YYLTYPE && ! defined YYLTYPE_IS_DECLARED
-typedef struct YYLTYPE YYLTYPE;
-struct YYLTYPE
+#include "goianinha.tab.h"
+/* Symbol kind.  */
+enum yysymbol_kind_t
 {
-  int first_line;
-  int first_column;
-  int last_line;
-  int last_column;
+  YYSYMBOL_YYEMPTY = -2,
+  YYSYMBOL_YYEOF = 0,                      /* "end of file"  */
+  YYSYMBOL_YYerror = 1,                    /* error  */
+  YYSYMBOL_YYUNDEF = 2,                    /* "invalid token"  */
+  YYSYMBOL_PROGRAMA = 3,                   /* PROGRAMA  */
+  YYSYMBOL_INT = 4,                        /* INT  */
+  YYSYMBOL_CAR = 5,                        /* CAR  */
+  YYSYMBOL_RETORNE = 6,                    /* RETORNE  */
+  YYSYMBOL_LEIA = 7,                       /* LEIA  */
+  YYSYMBOL_ESCREVA = 8,                    /* ESCREVA  */
+  YYSYMBOL_NOVALINHA = 9,                  /* NOVALINHA  */
+  YYSYMBOL_SE = 10,                        /* SE  */
+  YYSYMBOL_ENTAO = 11,                     /* ENTAO  */
+  YYSYMBOL_SENAO = 12,                     /* SENAO  */
+  YYSYMBOL_ENQUANTO = 13,                  /* ENQUANTO  */
+  YYSYMBOL_EXECUTE = 14,                   /* EXECUTE  */
+  YYSYMBOL_OU = 15,                        /* OU  */
+  YYSYMBOL_E = 16,                         /* E  */
+  YYSYMBOL_EQ = 17,                        /* EQ  */
+  YYSYMBOL_NEQ = 18,                       /* NEQ  */
+  YYSYMBOL_LEQ = 19,                       /* LEQ  */
+  YYSYMBOL_GEQ = 20,                       /* GEQ  */
+  YYSYMBOL_ID = 21,                        /* ID  */
+  YYSYMBOL_INTCONST = 22,                  /* INTCONST  */
+  YYSYMBOL_CARCONST = 23,                  /* CARCONST  */
+  YYSYMBOL_STRING = 24,                    /* STRING  */
+  YYSYMBOL_25_ = 25,                       /* '='  */
+  YYSYMBOL_26_ = 26,                       /* '<'  */
+  YYSYMBOL_27_ = 27,                       /* '>'  */
+  YYSYMBOL_28_ = 28,                       /* '+'  */
+  YYSYMBOL_29_ = 29,                       /* '-'  */
+  YYSYMBOL_30_ = 30,                       /* '*'  */
+  YYSYMBOL_31_ = 31,                       /* '/'  */
+  YYSYMBOL_UMINUS = 32,                    /* UMINUS  */
+  YYSYMBOL_33_ = 33,                       /* '!'  */
+  YYSYMBOL_34_ = 34,                       /* ';'  */
+  YYSYMBOL_35_ = 35,                       /* '('  */
+  YYSYMBOL_36_ = 36,                       /* ')'  */
+  YYSYMBOL_37_ = 37,                       /* ','  */
+  YYSYMBOL_38_ = 38,                       /* '{'  */
+  YYSYMBOL_39_ = 39,                       /* '}'  */
+  YYSYMBOL_YYACCEPT = 40,                  /* $accept  */
+  YYSYMBOL_Programa = 41,                  /* Programa  */
+  YYSYMBOL_DeclFuncVar = 42,               /* DeclFuncVar  */
+  YYSYMBOL_DeclFunc = 43,                  /* DeclFunc  */
+  YYSYMBOL_ListaDeclVar = 44,              /* ListaDeclVar  */
+  YYSYMBOL_DeclVar = 45,                   /* DeclVar  */
+  YYSYMBOL_Bloco = 46,                     /* Bloco  */
+  YYSYMBOL_ListaComando = 47,              /* ListaComando  */
+  YYSYMBOL_Comando = 48,                   /* Comando  */
+  YYSYMBOL_Expr = 49,                      /* Expr  */
+  YYSYMBOL_OrExpr = 50,                    /* OrExpr  */
+  YYSYMBOL_AndExpr = 51,                   /* AndExpr  */
+  YYSYMBOL_EqExpr = 52,                    /* EqExpr  */
+  YYSYMBOL_DesigExpr = 53,                 /* DesigExpr  */
+  YYSYMBOL_AddExpr = 54,                   /* AddExpr  */
+  YYSYMBOL_MulExpr = 55,                   /* MulExpr  */
+  YYSYMBOL_UnExpr = 56,                    /* UnExpr  */
+  YYSYMBOL_PrimExpr = 57,                  /* PrimExpr  */
+  YYSYMBOL_ListExpr = 58,                  /* ListExpr  */
+  YYSYMBOL_Tipo = 59,                      /* Tipo  */
+  YYSYMBOL_ListaParametros = 60,           /* ListaParametros  */
+  YYSYMBOL_ListaParametrosCont = 61,       /* ListaParametrosCont  */
+  YYSYMBOL_DeclProg = 62                   /* DeclProg  */
 };
-# define YYLTYPE_IS_DECLARED 1
-# define YYLTYPE_IS_TRIVIAL 1
-#endif
+typedef enum yysymbol_kind_t yysymbol_kind_t;
 
 
-extern YYSTYPE yylval;
-extern YYLTYPE yylloc;
-int yyparse (void);
-
-#endif /* !YY_YY_GOIANINHA_TAB_H_INCLUDED  */
-
 
 
 #ifdef short
@@ -234,6 +244,18 @@ typedef int_least16_t yytype_int16;
 typedef short yytype_int16;
 #endif
 
+/* Work around bug in HP-UX 11.23, which defines these macros
+   incorrectly for preprocessor constants.  This workaround can likely
+   be removed in 2023, as HPE has promised support for HP-UX 11.23
+   (aka HP-UX 11i v2) only through the end of 2022; see Table 2 of
+   <https://h20195.www2.hpe.com/V2/getpdf.aspx/4AA4-7673ENW.pdf>.  */
+#ifdef __hpux
+# undef UINT_LEAST8_MAX
+# undef UINT_LEAST16_MAX
+# define UINT_LEAST8_MAX 255
+# define UINT_LEAST16_MAX 65535
+#endif
+
 #if defined __UINT_LEAST8_MAX__ && __UINT_LEAST8_MAX__ <= __INT_MAX__
 typedef __UINT_LEAST8_TYPE__ yytype_uint8;
 #elif (!defined __UINT_LEAST8_MAX__ && defined YY_STDINT_H \
@@ -293,6 +315,7 @@ typedef int yytype_uint16;
 
 #define YYSIZEOF(X) YY_CAST (YYPTRDIFF_T, sizeof (X))
 
+
 /* Stored state numbers (used for stacks). */
 typedef yytype_int8 yy_state_t;
 
@@ -311,6 +334,7 @@ typedef int yy_state_fast_t;
 # endif
 #endif
 
+
 #ifndef YY_ATTRIBUTE_PURE
 # if defined __GNUC__ && 2 < __GNUC__ + (96 <= __GNUC_MINOR__)
 #  define YY_ATTRIBUTE_PURE __attribute__ ((__pure__))
@@ -329,17 +353,23 @@ typedef int yy_state_fast_t;
 
 /* Suppress unused-variable warnings by "using" E.  */
 #if ! defined lint || defined __GNUC__
-# define YYUSE(E) ((void) (E))
+# define YY_USE(E) ((void) (E))
 #else
-# define YYUSE(E) /* empty */
+# define YY_USE(E) /* empty */
 #endif
 
-#if defined __GNUC__ && ! defined __ICC && 407 <= __GNUC__ * 100 + __GNUC_MINOR__
 /* Suppress an incorrect diagnostic about yylval being uninitialized.  */
-# define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                            \
+#if defined __GNUC__ && ! defined __ICC && 406 <= __GNUC__ * 100 + __GNUC_MINOR__
+# if __GNUC__ * 100 + __GNUC_MINOR__ < 407
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")
+# else
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
     _Pragma ("GCC diagnostic push")                                     \
     _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")              \
     _Pragma ("GCC diagnostic ignored \"-Wmaybe-uninitialized\"")
+# endif
 # define YY_IGNORE_MAYBE_UNINITIALIZED_END      \
     _Pragma ("GCC diagnostic pop")
 #else
@@ -368,7 +398,7 @@ typedef int yy_state_fast_t;
 
 #define YY_ASSERT(E) ((void) (0 && (E)))
 
-#if ! defined yyoverflow || YYERROR_VERBOSE
+#if !defined yyoverflow
 
 /* The parser invokes alloca or malloc; define the necessary symbols.  */
 
@@ -433,8 +463,7 @@ void free (void *); /* INFRINGES ON USER NAME SPACE */
 #   endif
 #  endif
 # endif
-#endif /* ! defined yyoverflow || YYERROR_VERBOSE */
-
+#endif /* !defined yyoverflow */
 
 #if (! defined yyoverflow \
      && (! defined __cplusplus \
@@ -502,7 +531,7 @@ union yyalloc
 /* YYFINAL -- State number of the termination state.  */
 #define YYFINAL  3
 /* YYLAST -- Last index in YYTABLE.  */
-#define YYLAST   138
+#define YYLAST   137
 
 /* YYNTOKENS -- Number of terminals.  */
 #define YYNTOKENS  40
@@ -511,16 +540,18 @@ union yyalloc
 /* YYNRULES -- Number of rules.  */
 #define YYNRULES  62
 /* YYNSTATES -- Number of states.  */
-#define YYNSTATES  119
+#define YYNSTATES  118
 
-#define YYUNDEFTOK  2
+/* YYMAXUTOK -- Last valid token kind.  */
 #define YYMAXUTOK   280
 
 
 /* YYTRANSLATE(TOKEN-NUM) -- Symbol number corresponding to TOKEN-NUM
    as returned by yylex, with out-of-bounds checking.  */
-#define YYTRANSLATE(YYX)                                                \
-  (0 <= (YYX) && (YYX) <= YYMAXUTOK ? yytranslate[YYX] : YYUNDEFTOK)
+#define YYTRANSLATE(YYX)                                \
+  (0 <= (YYX) && (YYX) <= YYMAXUTOK                     \
+   ? YY_CAST (yysymbol_kind_t, yytranslate[YYX])        \
+   : YYSYMBOL_YYUNDEF)
 
 /* YYTRANSLATE[TOKEN-NUM] -- Symbol number corresponding to TOKEN-NUM
    as returned by yylex.  */
@@ -558,49 +589,51 @@ static const yytype_int8 yytranslate[] =
 };
 
 #if YYDEBUG
-  /* YYRLINE[YYN] -- Source line where rule number YYN was defined.  */
+/* YYRLINE[YYN] -- Source line where rule number YYN was defined.  */
 static const yytype_int16 yyrline[] =
 {
-       0,    61,    61,    74,    77,    99,   113,   122,   124,   145,
-     147,   158,   167,   169,   181,   183,   185,   188,   194,   197,
-     203,   206,   209,   215,   218,   226,   229,   237,   239,   244,
-     246,   251,   252,   253,   257,   258,   259,   260,   261,   265,
-     266,   267,   271,   272,   273,   277,   278,   279,   283,   289,
-     290,   291,   292,   293,   297,   299,   310,   311,   319,   320,
-     325,   331,   344
+       0,    93,    93,   107,   110,   129,   140,   149,   151,   170,
+     172,   181,   192,   194,   205,   207,   209,   212,   218,   221,
+     227,   230,   233,   239,   242,   250,   253,   261,   263,   268,
+     270,   275,   276,   277,   281,   282,   283,   284,   285,   289,
+     290,   291,   295,   296,   297,   301,   302,   303,   307,   312,
+     313,   314,   315,   324,   328,   333,   344,   345,   353,   354,
+     359,   366,   379
 };
 #endif
 
-#if YYDEBUG || YYERROR_VERBOSE || 0
+/** Accessing symbol of state STATE.  */
+#define YY_ACCESSING_SYMBOL(State) YY_CAST (yysymbol_kind_t, yystos[State])
+
+#if YYDEBUG || 0
+/* The user-facing name of the symbol whose (internal) number is
+   YYSYMBOL.  No bounds checking.  */
+static const char *yysymbol_name (yysymbol_kind_t yysymbol) YY_ATTRIBUTE_UNUSED;
+
 /* YYTNAME[SYMBOL-NUM] -- String name of the symbol SYMBOL-NUM.
    First, the terminals, then, starting at YYNTOKENS, nonterminals.  */
 static const char *const yytname[] =
 {
-  "$end", "error", "$undefined", "PROGRAMA", "INT", "CAR", "RETORNE",
-  "LEIA", "ESCREVA", "NOVALINHA", "SE", "ENTAO", "SENAO", "ENQUANTO",
-  "EXECUTE", "OU", "E", "EQ", "NEQ", "LEQ", "GEQ", "ID", "INTCONST",
-  "CARCONST", "STRING", "'='", "'<'", "'>'", "'+'", "'-'", "'*'", "'/'",
-  "UMINUS", "'!'", "';'", "'('", "')'", "','", "'{'", "'}'", "$accept",
-  "Programa", "DeclFuncVar", "DeclFunc", "ListaDeclVar", "DeclVar",
-  "Bloco", "ListaComando", "Comando", "Expr", "OrExpr", "AndExpr",
-  "EqExpr", "DesigExpr", "AddExpr", "MulExpr", "UnExpr", "PrimExpr",
-  "ListExpr", "Tipo", "ListaParametros", "ListaParametrosCont", "DeclProg", YY_NULLPTR
+  "\"end of file\"", "error", "\"invalid token\"", "PROGRAMA", "INT",
+  "CAR", "RETORNE", "LEIA", "ESCREVA", "NOVALINHA", "SE", "ENTAO", "SENAO",
+  "ENQUANTO", "EXECUTE", "OU", "E", "EQ", "NEQ", "LEQ", "GEQ", "ID",
+  "INTCONST", "CARCONST", "STRING", "'='", "'<'", "'>'", "'+'", "'-'",
+  "'*'", "'/'", "UMINUS", "'!'", "';'", "'('", "')'", "','", "'{'", "'}'",
+  "$accept", "Programa", "DeclFuncVar", "DeclFunc", "ListaDeclVar",
+  "DeclVar", "Bloco", "ListaComando", "Comando", "Expr", "OrExpr",
+  "AndExpr", "EqExpr", "DesigExpr", "AddExpr", "MulExpr", "UnExpr",
+  "PrimExpr", "ListExpr", "Tipo", "ListaParametros", "ListaParametrosCont",
+  "DeclProg", YY_NULLPTR
 };
-#endif
 
-# ifdef YYPRINT
-/* YYTOKNUM[NUM] -- (External) token number corresponding to the
-   (internal) symbol number NUM (which must be that of a token).  */
-static const yytype_int16 yytoknum[] =
+static const char *
+yysymbol_name (yysymbol_kind_t yysymbol)
 {
-       0,   256,   257,   258,   259,   260,   261,   262,   263,   264,
-     265,   266,   267,   268,   269,   270,   271,   272,   273,   274,
-     275,   276,   277,   278,   279,    61,    60,    62,    43,    45,
-      42,    47,   280,    33,    59,    40,    41,    44,   123,   125
-};
-# endif
+  return yytname[yysymbol];
+}
+#endif
 
-#define YYPACT_NINF (-100)
+#define YYPACT_NINF (-30)
 
 #define yypact_value_is_default(Yyn) \
   ((Yyn) == YYPACT_NINF)
@@ -610,117 +643,117 @@ static const yytype_int16 yytoknum[] =
 #define yytable_value_is_error(Yyn) \
   0
 
-  /* YYPACT[STATE-NUM] -- Index in YYTABLE of the portion describing
-     STATE-NUM.  */
+/* YYPACT[STATE-NUM] -- Index in YYTABLE of the portion describing
+   STATE-NUM.  */
 static const yytype_int8 yypact[] =
 {
-    -100,    19,    29,  -100,    -9,  -100,  -100,    54,  -100,  -100,
-    -100,   -20,    65,    65,    86,  -100,    24,    18,    89,    93,
-      46,    49,    78,  -100,    73,    95,    50,    83,    84,    85,
-     -14,  -100,  -100,    76,    76,  -100,    73,  -100,  -100,  -100,
-      87,   103,   106,    37,    40,    52,    61,  -100,  -100,    78,
-    -100,    -9,    65,  -100,    90,    91,    92,    94,  -100,    73,
-      73,    73,   -13,    88,  -100,  -100,    96,  -100,    76,    76,
-      76,    76,    76,    76,    76,    76,    76,    76,    76,    76,
-      97,  -100,   108,  -100,  -100,  -100,  -100,    98,    99,  -100,
-    -100,  -100,    64,  -100,   106,    37,    40,    40,    52,    52,
-      52,    52,    61,    61,  -100,  -100,  -100,  -100,   116,   119,
-    -100,    73,    55,    55,  -100,   118,  -100,    55,  -100
+     -30,    11,   107,   -30,   -11,   -30,   -30,     2,   -30,   -30,
+     -30,    -6,     9,     9,   -30,    23,    33,    10,    13,    14,
+       8,   -30,    43,    -5,    71,    62,    65,    82,    83,   -15,
+     -30,   -30,    30,    30,   -30,    -5,   -30,   -30,   -30,    85,
+     105,   106,    52,     6,    50,    51,   -30,   -30,   -30,   -30,
+     -11,     9,   -30,    87,    89,    90,    91,   -30,    -5,    -5,
+      -5,   -14,    92,   -30,   -30,    93,   -30,    30,    30,    30,
+      30,    30,    30,    30,    30,    30,    30,    30,    30,    24,
+     -30,   109,   -30,   -30,   -30,   -30,    95,    96,   -30,   -30,
+     -30,    77,   -30,   106,    52,     6,     6,    50,    50,    50,
+      50,    51,    51,   -30,   -30,   -30,   -30,   115,   114,   -30,
+      -5,    67,    67,   -30,   121,   -30,    67,   -30
 };
 
-  /* YYDEFACT[STATE-NUM] -- Default reduction number in state STATE-NUM.
-     Performed when YYTABLE does not specify something else to do.  Zero
-     means the default is an error.  */
+/* YYDEFACT[STATE-NUM] -- Default reduction number in state STATE-NUM.
+   Performed when YYTABLE does not specify something else to do.  Zero
+   means the default is an error.  */
 static const yytype_int8 yydefact[] =
 {
        3,     0,     0,     1,     0,    56,    57,     0,     2,     7,
-      62,     9,    12,    58,     0,     5,     0,     0,     0,     0,
-       0,    59,     9,     4,     0,     0,     0,     0,     0,     0,
-      50,    52,    51,     0,     0,    14,     0,    11,    24,    13,
-       0,    25,    28,    30,    33,    38,    41,    44,    47,     9,
-      60,     0,     0,    10,     0,     0,     0,     0,    20,     0,
-       0,     0,     0,    50,    45,    46,     0,    15,     0,     0,
+      62,     9,    12,    58,     5,     0,     0,     0,     0,     0,
+      59,     4,     0,     0,     0,     0,     0,     0,     0,    50,
+      52,    51,     0,     0,    14,     0,    11,    24,    13,     0,
+      25,    28,    30,    33,    38,    41,    44,    47,     9,    60,
+       0,     0,    10,     0,     0,     0,     0,    20,     0,     0,
+       0,     0,    50,    45,    46,     0,    15,     0,     0,     0,
        0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
-       0,     6,     0,    16,    17,    19,    18,     0,     0,    26,
-      49,    54,     0,    53,    27,    29,    31,    32,    36,    37,
-      34,    35,    39,    40,    42,    43,     8,    61,     0,     0,
-      48,     0,     0,     0,    55,    21,    23,     0,    22
+       6,     0,    16,    17,    19,    18,     0,     0,    26,    49,
+      54,     0,    53,    27,    29,    31,    32,    36,    37,    34,
+      35,    39,    40,    42,    43,     8,    61,     0,     0,    48,
+       0,     0,     0,    55,    21,    23,     0,    22
 };
 
-  /* YYPGOTO[NTERM-NUM].  */
+/* YYPGOTO[NTERM-NUM].  */
 static const yytype_int8 yypgoto[] =
 {
-    -100,  -100,  -100,  -100,  -100,   -19,    -3,  -100,   -99,   -24,
-    -100,    68,    69,    33,   -30,    36,   -29,  -100,  -100,    -6,
-    -100,  -100,  -100
+     -30,   -30,   -30,   -30,   -30,    86,    -3,   -30,   -18,   -23,
+     -30,    68,    69,    34,    35,    40,   -29,   -30,   -30,    -7,
+     -30,   -30,   -30
 };
 
-  /* YYDEFGOTO[NTERM-NUM].  */
+/* YYDEFGOTO[NTERM-NUM].  */
 static const yytype_int8 yydefgoto[] =
 {
-      -1,     1,     2,    15,    12,    16,    38,    17,    39,    40,
-      41,    42,    43,    44,    45,    46,    47,    48,    92,     7,
-      20,    21,     8
+       0,     1,     2,    14,    12,    15,    37,    16,    38,    39,
+      40,    41,    42,    43,    44,    45,    46,    47,    91,     7,
+      19,    20,     8
 };
 
-  /* YYTABLE[YYPACT[STATE-NUM]] -- What to do in state STATE-NUM.  If
-     positive, shift that token.  If negative, reduce the rule whose
-     number is the opposite.  If YYTABLE_NINF, syntax error.  */
+/* YYTABLE[YYPACT[STATE-NUM]] -- What to do in state STATE-NUM.  If
+   positive, shift that token.  If negative, reduce the rule whose
+   number is the opposite.  If YYTABLE_NINF, syntax error.  */
 static const yytype_int8 yytable[] =
 {
-      54,    10,    57,    53,    64,    65,    18,    19,    30,    31,
-      32,    61,    66,   115,   116,    13,    33,    14,   118,     3,
-      34,    62,    36,    90,    24,    25,    26,    27,    28,     9,
-      80,    29,     4,     5,     6,    87,    88,    89,    91,    30,
-      31,    32,    98,    99,   100,   101,    82,    33,    81,   104,
-     105,    34,    35,    36,    70,    71,     9,    37,    23,    72,
-      73,    24,    25,    26,    27,    28,    74,    75,    29,     5,
-       6,    30,    31,    32,    56,    11,    30,    31,    32,    33,
-      76,    77,    51,    34,    33,    36,    52,   114,    34,    35,
-      36,    78,    79,     9,    30,    31,    32,    63,    31,    32,
-     110,   111,    33,    96,    97,    33,    34,    22,    36,    34,
-      49,    36,   102,   103,    50,    14,    55,    58,    68,    59,
-      60,    67,    69,    62,    83,    84,    85,   112,    86,   107,
-     117,   106,    93,   113,   108,   109,    94,     0,    95
+      53,    10,    56,    63,    64,    17,    18,    29,    30,    31,
+      60,     3,    65,     5,     6,    32,    29,    30,    31,    33,
+      61,    35,    89,    11,    32,    71,    72,     9,    33,    13,
+      35,    48,    73,    74,    49,    86,    87,    88,    90,    23,
+      24,    25,    26,    27,    81,    51,    28,    80,   103,   104,
+      50,    62,    30,    31,    29,    30,    31,    21,   105,    32,
+      22,    22,    32,    33,    52,    35,    33,    34,    35,    69,
+      70,     9,    36,    23,    24,    25,    26,    27,    75,    76,
+      28,    77,    78,    29,    30,    31,    55,   113,    29,    30,
+      31,    32,    54,   114,   115,    33,    32,    35,   117,    57,
+      33,    34,    35,    95,    96,     9,    97,    98,    99,   100,
+       4,     5,     6,   109,   110,   101,   102,    58,    59,    66,
+      67,    82,    68,    83,    84,    85,   111,    61,   112,    92,
+     106,   107,   108,   116,    79,    93,     0,    94
 };
 
 static const yytype_int8 yycheck[] =
 {
-      24,     4,    26,    22,    33,    34,    12,    13,    21,    22,
-      23,    25,    36,   112,   113,    35,    29,    37,   117,     0,
-      33,    35,    35,    36,     6,     7,     8,     9,    10,    38,
-      49,    13,     3,     4,     5,    59,    60,    61,    62,    21,
-      22,    23,    72,    73,    74,    75,    52,    29,    51,    78,
-      79,    33,    34,    35,    17,    18,    38,    39,    34,    19,
-      20,     6,     7,     8,     9,    10,    26,    27,    13,     4,
-       5,    21,    22,    23,    24,    21,    21,    22,    23,    29,
-      28,    29,    36,    33,    29,    35,    37,   111,    33,    34,
-      35,    30,    31,    38,    21,    22,    23,    21,    22,    23,
-      36,    37,    29,    70,    71,    29,    33,    21,    35,    33,
-      21,    35,    76,    77,    21,    37,    21,    34,    15,    35,
-      35,    34,    16,    35,    34,    34,    34,    11,    34,    21,
-      12,    34,    36,    14,    36,    36,    68,    -1,    69
+      23,     4,    25,    32,    33,    12,    13,    21,    22,    23,
+      25,     0,    35,     4,     5,    29,    21,    22,    23,    33,
+      35,    35,    36,    21,    29,    19,    20,    38,    33,    35,
+      35,    21,    26,    27,    21,    58,    59,    60,    61,     6,
+       7,     8,     9,    10,    51,    37,    13,    50,    77,    78,
+      36,    21,    22,    23,    21,    22,    23,    34,    34,    29,
+      37,    37,    29,    33,    21,    35,    33,    34,    35,    17,
+      18,    38,    39,     6,     7,     8,     9,    10,    28,    29,
+      13,    30,    31,    21,    22,    23,    24,   110,    21,    22,
+      23,    29,    21,   111,   112,    33,    29,    35,   116,    34,
+      33,    34,    35,    69,    70,    38,    71,    72,    73,    74,
+       3,     4,     5,    36,    37,    75,    76,    35,    35,    34,
+      15,    34,    16,    34,    34,    34,    11,    35,    14,    36,
+      21,    36,    36,    12,    48,    67,    -1,    68
 };
 
-  /* YYSTOS[STATE-NUM] -- The (internal number of the) accessing
-     symbol of state STATE-NUM.  */
+/* YYSTOS[STATE-NUM] -- The symbol kind of the accessing symbol of
+   state STATE-NUM.  */
 static const yytype_int8 yystos[] =
 {
        0,    41,    42,     0,     3,     4,     5,    59,    62,    38,
-      46,    21,    44,    35,    37,    43,    45,    47,    59,    59,
-      60,    61,    21,    34,     6,     7,     8,     9,    10,    13,
-      21,    22,    23,    29,    33,    34,    35,    39,    46,    48,
-      49,    50,    51,    52,    53,    54,    55,    56,    57,    21,
-      21,    36,    37,    45,    49,    21,    24,    49,    34,    35,
-      35,    25,    35,    21,    56,    56,    49,    34,    15,    16,
-      17,    18,    19,    20,    26,    27,    28,    29,    30,    31,
-      45,    46,    59,    34,    34,    34,    34,    49,    49,    49,
-      36,    49,    58,    36,    51,    52,    53,    53,    54,    54,
-      54,    54,    55,    55,    56,    56,    34,    21,    36,    36,
-      36,    37,    11,    14,    49,    48,    48,    12,    48
+      46,    21,    44,    35,    43,    45,    47,    59,    59,    60,
+      61,    34,    37,     6,     7,     8,     9,    10,    13,    21,
+      22,    23,    29,    33,    34,    35,    39,    46,    48,    49,
+      50,    51,    52,    53,    54,    55,    56,    57,    21,    21,
+      36,    37,    21,    49,    21,    24,    49,    34,    35,    35,
+      25,    35,    21,    56,    56,    49,    34,    15,    16,    17,
+      18,    19,    20,    26,    27,    28,    29,    30,    31,    45,
+      46,    59,    34,    34,    34,    34,    49,    49,    49,    36,
+      49,    58,    36,    51,    52,    53,    53,    54,    54,    54,
+      54,    55,    55,    56,    56,    34,    21,    36,    36,    36,
+      37,    11,    14,    49,    48,    48,    12,    48
 };
 
-  /* YYR1[YYN] -- Symbol number of symbol that rule YYN derives.  */
+/* YYR1[RULE-NUM] -- Symbol kind of the left-hand side of rule RULE-NUM.  */
 static const yytype_int8 yyr1[] =
 {
        0,    40,    41,    42,    42,    42,    43,    44,    44,    45,
@@ -732,7 +765,7 @@ static const yytype_int8 yyr1[] =
       61,    61,    62
 };
 
-  /* YYR2[YYN] -- Number of symbols on the right hand side of rule YYN.  */
+/* YYR2[RULE-NUM] -- Number of symbols on the right-hand side of rule RULE-NUM.  */
 static const yytype_int8 yyr2[] =
 {
        0,     2,     2,     0,     5,     4,     4,     0,     5,     0,
@@ -745,14 +778,15 @@ static const yytype_int8 yyr2[] =
 };
 
 
+enum { YYENOMEM = -2 };
+
 #define yyerrok         (yyerrstatus = 0)
 #define yyclearin       (yychar = YYEMPTY)
-#define YYEMPTY         (-2)
-#define YYEOF           0
 
 #define YYACCEPT        goto yyacceptlab
 #define YYABORT         goto yyabortlab
 #define YYERROR         goto yyerrorlab
+#define YYNOMEM         goto yyexhaustedlab
 
 
 #define YYRECOVERING()  (!!yyerrstatus)
@@ -774,10 +808,9 @@ static const yytype_int8 yyr2[] =
       }                                                           \
   while (0)
 
-/* Error token number */
-#define YYTERROR        1
-#define YYERRCODE       256
-
+/* Backward compatibility with an undocumented macro.
+   Use YYerror or YYUNDEF. */
+#define YYERRCODE YYUNDEF
 
 /* YYLLOC_DEFAULT -- Set CURRENT to span from RHS[1] to RHS[N].
    If N is 0, then set CURRENT to the empty location which ends
@@ -821,12 +854,19 @@ do {                                            \
 } while (0)
 
 
-/* YY_LOCATION_PRINT -- Print the location on the stream.
+/* YYLOCATION_PRINT -- Print the location on the stream.
    This macro was not mandated originally: define only if we know
    we won't break user code: when these are the locations we know.  */
 
-#ifndef YY_LOCATION_PRINT
-# if defined YYLTYPE_IS_TRIVIAL && YYLTYPE_IS_TRIVIAL
+# ifndef YYLOCATION_PRINT
+
+#  if defined YY_LOCATION_PRINT
+
+   /* Temporary convenience wrapper in case some people defined the
+      undocumented and private YY_LOCATION_PRINT macros.  */
+#   define YYLOCATION_PRINT(File, Loc)  YY_LOCATION_PRINT(File, *(Loc))
+
+#  elif defined YYLTYPE_IS_TRIVIAL && YYLTYPE_IS_TRIVIAL
 
 /* Print *YYLOCP on YYO.  Private, do not rely on its existence. */
 
@@ -854,24 +894,32 @@ yy_location_print_ (FILE *yyo, YYLTYPE const * const yylocp)
         res += YYFPRINTF (yyo, "-%d", end_col);
     }
   return res;
- }
+}
 
-#  define YY_LOCATION_PRINT(File, Loc)          \
-  yy_location_print_ (File, &(Loc))
+#   define YYLOCATION_PRINT  yy_location_print_
 
-# else
-#  define YY_LOCATION_PRINT(File, Loc) ((void) 0)
-# endif
-#endif
+    /* Temporary convenience wrapper in case some people defined the
+       undocumented and private YY_LOCATION_PRINT macros.  */
+#   define YY_LOCATION_PRINT(File, Loc)  YYLOCATION_PRINT(File, &(Loc))
+
+#  else
+
+#   define YYLOCATION_PRINT(File, Loc) ((void) 0)
+    /* Temporary convenience wrapper in case some people defined the
+       undocumented and private YY_LOCATION_PRINT macros.  */
+#   define YY_LOCATION_PRINT  YYLOCATION_PRINT
+
+#  endif
+# endif /* !defined YYLOCATION_PRINT */
 
 
-# define YY_SYMBOL_PRINT(Title, Type, Value, Location)                    \
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)                    \
 do {                                                                      \
   if (yydebug)                                                            \
     {                                                                     \
       YYFPRINTF (stderr, "%s ", Title);                                   \
       yy_symbol_print (stderr,                                            \
-                  Type, Value, Location); \
+                  Kind, Value, Location); \
       YYFPRINTF (stderr, "\n");                                           \
     }                                                                     \
 } while (0)
@@ -882,19 +930,16 @@ do {                                                                      \
 `-----------------------------------*/
 
 static void
-yy_symbol_value_print (FILE *yyo, int yytype, YYSTYPE const * const yyvaluep, YYLTYPE const * const yylocationp)
+yy_symbol_value_print (FILE *yyo,
+                       yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep, YYLTYPE const * const yylocationp)
 {
   FILE *yyoutput = yyo;
-  YYUSE (yyoutput);
-  YYUSE (yylocationp);
+  YY_USE (yyoutput);
+  YY_USE (yylocationp);
   if (!yyvaluep)
     return;
-# ifdef YYPRINT
-  if (yytype < YYNTOKENS)
-    YYPRINT (yyo, yytoknum[yytype], *yyvaluep);
-# endif
   YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
-  YYUSE (yytype);
+  YY_USE (yykind);
   YY_IGNORE_MAYBE_UNINITIALIZED_END
 }
 
@@ -904,14 +949,15 @@ yy_symbol_value_print (FILE *yyo, int yytype, YYSTYPE const * const yyvaluep, YY
 `---------------------------*/
 
 static void
-yy_symbol_print (FILE *yyo, int yytype, YYSTYPE const * const yyvaluep, YYLTYPE const * const yylocationp)
+yy_symbol_print (FILE *yyo,
+                 yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep, YYLTYPE const * const yylocationp)
 {
   YYFPRINTF (yyo, "%s %s (",
-             yytype < YYNTOKENS ? "token" : "nterm", yytname[yytype]);
+             yykind < YYNTOKENS ? "token" : "nterm", yysymbol_name (yykind));
 
-  YY_LOCATION_PRINT (yyo, *yylocationp);
+  YYLOCATION_PRINT (yyo, yylocationp);
   YYFPRINTF (yyo, ": ");
-  yy_symbol_value_print (yyo, yytype, yyvaluep, yylocationp);
+  yy_symbol_value_print (yyo, yykind, yyvaluep, yylocationp);
   YYFPRINTF (yyo, ")");
 }
 
@@ -944,7 +990,8 @@ do {                                                            \
 `------------------------------------------------*/
 
 static void
-yy_reduce_print (yy_state_t *yyssp, YYSTYPE *yyvsp, YYLTYPE *yylsp, int yyrule)
+yy_reduce_print (yy_state_t *yyssp, YYSTYPE *yyvsp, YYLTYPE *yylsp,
+                 int yyrule)
 {
   int yylno = yyrline[yyrule];
   int yynrhs = yyr2[yyrule];
@@ -956,9 +1003,9 @@ yy_reduce_print (yy_state_t *yyssp, YYSTYPE *yyvsp, YYLTYPE *yylsp, int yyrule)
     {
       YYFPRINTF (stderr, "   $%d = ", yyi + 1);
       yy_symbol_print (stderr,
-                       yystos[+yyssp[yyi + 1 - yynrhs]],
-                       &yyvsp[(yyi + 1) - (yynrhs)]
-                       , &(yylsp[(yyi + 1) - (yynrhs)])                       );
+                       YY_ACCESSING_SYMBOL (+yyssp[yyi + 1 - yynrhs]),
+                       &yyvsp[(yyi + 1) - (yynrhs)],
+                       &(yylsp[(yyi + 1) - (yynrhs)]));
       YYFPRINTF (stderr, "\n");
     }
 }
@@ -973,8 +1020,8 @@ do {                                    \
    multiple parsers can coexist.  */
 int yydebug;
 #else /* !YYDEBUG */
-# define YYDPRINTF(Args)
-# define YY_SYMBOL_PRINT(Title, Type, Value, Location)
+# define YYDPRINTF(Args) ((void) 0)
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)
 # define YY_STACK_PRINT(Bottom, Top)
 # define YY_REDUCE_PRINT(Rule)
 #endif /* !YYDEBUG */
@@ -997,260 +1044,31 @@ int yydebug;
 #endif
 
 
-#if YYERROR_VERBOSE
-
-# ifndef yystrlen
-#  if defined __GLIBC__ && defined _STRING_H
-#   define yystrlen(S) (YY_CAST (YYPTRDIFF_T, strlen (S)))
-#  else
-/* Return the length of YYSTR.  */
-static YYPTRDIFF_T
-yystrlen (const char *yystr)
-{
-  YYPTRDIFF_T yylen;
-  for (yylen = 0; yystr[yylen]; yylen++)
-    continue;
-  return yylen;
-}
-#  endif
-# endif
-
-# ifndef yystpcpy
-#  if defined __GLIBC__ && defined _STRING_H && defined _GNU_SOURCE
-#   define yystpcpy stpcpy
-#  else
-/* Copy YYSRC to YYDEST, returning the address of the terminating '\0' in
-   YYDEST.  */
-static char *
-yystpcpy (char *yydest, const char *yysrc)
-{
-  char *yyd = yydest;
-  const char *yys = yysrc;
-
-  while ((*yyd++ = *yys++) != '\0')
-    continue;
-
-  return yyd - 1;
-}
-#  endif
-# endif
-
-# ifndef yytnamerr
-/* Copy to YYRES the contents of YYSTR after stripping away unnecessary
-   quotes and backslashes, so that it's suitable for yyerror.  The
-   heuristic is that double-quoting is unnecessary unless the string
-   contains an apostrophe, a comma, or backslash (other than
-   backslash-backslash).  YYSTR is taken from yytname.  If YYRES is
-   null, do not copy; instead, return the length of what the result
-   would have been.  */
-static YYPTRDIFF_T
-yytnamerr (char *yyres, const char *yystr)
-{
-  if (*yystr == '"')
-    {
-      YYPTRDIFF_T yyn = 0;
-      char const *yyp = yystr;
-
-      for (;;)
-        switch (*++yyp)
-          {
-          case '\'':
-          case ',':
-            goto do_not_strip_quotes;
-
-          case '\\':
-            if (*++yyp != '\\')
-              goto do_not_strip_quotes;
-            else
-              goto append;
-
-          append:
-          default:
-            if (yyres)
-              yyres[yyn] = *yyp;
-            yyn++;
-            break;
-
-          case '"':
-            if (yyres)
-              yyres[yyn] = '\0';
-            return yyn;
-          }
-    do_not_strip_quotes: ;
-    }
-
-  if (yyres)
-    return yystpcpy (yyres, yystr) - yyres;
-  else
-    return yystrlen (yystr);
-}
-# endif
-
-/* Copy into *YYMSG, which is of size *YYMSG_ALLOC, an error message
-   about the unexpected token YYTOKEN for the state stack whose top is
-   YYSSP.
-
-   Return 0 if *YYMSG was successfully written.  Return 1 if *YYMSG is
-   not large enough to hold the message.  In that case, also set
-   *YYMSG_ALLOC to the required number of bytes.  Return 2 if the
-   required number of bytes is too large to store.  */
-static int
-yysyntax_error (YYPTRDIFF_T *yymsg_alloc, char **yymsg,
-                yy_state_t *yyssp, int yytoken)
-{
-  enum { YYERROR_VERBOSE_ARGS_MAXIMUM = 5 };
-  /* Internationalized format string. */
-  const char *yyformat = YY_NULLPTR;
-  /* Arguments of yyformat: reported tokens (one for the "unexpected",
-     one per "expected"). */
-  char const *yyarg[YYERROR_VERBOSE_ARGS_MAXIMUM];
-  /* Actual size of YYARG. */
-  int yycount = 0;
-  /* Cumulated lengths of YYARG.  */
-  YYPTRDIFF_T yysize = 0;
-
-  /* There are many possibilities here to consider:
-     - If this state is a consistent state with a default action, then
-       the only way this function was invoked is if the default action
-       is an error action.  In that case, don't check for expected
-       tokens because there are none.
-     - The only way there can be no lookahead present (in yychar) is if
-       this state is a consistent state with a default action.  Thus,
-       detecting the absence of a lookahead is sufficient to determine
-       that there is no unexpected or expected token to report.  In that
-       case, just report a simple "syntax error".
-     - Don't assume there isn't a lookahead just because this state is a
-       consistent state with a default action.  There might have been a
-       previous inconsistent state, consistent state with a non-default
-       action, or user semantic action that manipulated yychar.
-     - Of course, the expected token list depends on states to have
-       correct lookahead information, and it depends on the parser not
-       to perform extra reductions after fetching a lookahead from the
-       scanner and before detecting a syntax error.  Thus, state merging
-       (from LALR or IELR) and default reductions corrupt the expected
-       token list.  However, the list is correct for canonical LR with
-       one exception: it will still contain any token that will not be
-       accepted due to an error action in a later state.
-  */
-  if (yytoken != YYEMPTY)
-    {
-      int yyn = yypact[+*yyssp];
-      YYPTRDIFF_T yysize0 = yytnamerr (YY_NULLPTR, yytname[yytoken]);
-      yysize = yysize0;
-      yyarg[yycount++] = yytname[yytoken];
-      if (!yypact_value_is_default (yyn))
-        {
-          /* Start YYX at -YYN if negative to avoid negative indexes in
-             YYCHECK.  In other words, skip the first -YYN actions for
-             this state because they are default actions.  */
-          int yyxbegin = yyn < 0 ? -yyn : 0;
-          /* Stay within bounds of both yycheck and yytname.  */
-          int yychecklim = YYLAST - yyn + 1;
-          int yyxend = yychecklim < YYNTOKENS ? yychecklim : YYNTOKENS;
-          int yyx;
-
-          for (yyx = yyxbegin; yyx < yyxend; ++yyx)
-            if (yycheck[yyx + yyn] == yyx && yyx != YYTERROR
-                && !yytable_value_is_error (yytable[yyx + yyn]))
-              {
-                if (yycount == YYERROR_VERBOSE_ARGS_MAXIMUM)
-                  {
-                    yycount = 1;
-                    yysize = yysize0;
-                    break;
-                  }
-                yyarg[yycount++] = yytname[yyx];
-                {
-                  YYPTRDIFF_T yysize1
-                    = yysize + yytnamerr (YY_NULLPTR, yytname[yyx]);
-                  if (yysize <= yysize1 && yysize1 <= YYSTACK_ALLOC_MAXIMUM)
-                    yysize = yysize1;
-                  else
-                    return 2;
-                }
-              }
-        }
-    }
 
-  switch (yycount)
-    {
-# define YYCASE_(N, S)                      \
-      case N:                               \
-        yyformat = S;                       \
-      break
-    default: /* Avoid compiler warnings. */
-      YYCASE_(0, YY_("syntax error"));
-      YYCASE_(1, YY_("syntax error, unexpected %s"));
-      YYCASE_(2, YY_("syntax error, unexpected %s, expecting %s"));
-      YYCASE_(3, YY_("syntax error, unexpected %s, expecting %s or %s"));
-      YYCASE_(4, YY_("syntax error, unexpected %s, expecting %s or %s or %s"));
-      YYCASE_(5, YY_("syntax error, unexpected %s, expecting %s or %s or %s or %s"));
-# undef YYCASE_
-    }
 
-  {
-    /* Don't count the "%s"s in the final size, but reserve room for
-       the terminator.  */
-    YYPTRDIFF_T yysize1 = yysize + (yystrlen (yyformat) - 2 * yycount) + 1;
-    if (yysize <= yysize1 && yysize1 <= YYSTACK_ALLOC_MAXIMUM)
-      yysize = yysize1;
-    else
-      return 2;
-  }
 
-  if (*yymsg_alloc < yysize)
-    {
-      *yymsg_alloc = 2 * yysize;
-      if (! (yysize <= *yymsg_alloc
-             && *yymsg_alloc <= YYSTACK_ALLOC_MAXIMUM))
-        *yymsg_alloc = YYSTACK_ALLOC_MAXIMUM;
-      return 1;
-    }
-
-  /* Avoid sprintf, as that infringes on the user's name space.
-     Don't have undefined behavior even if the translation
-     produced a string with the wrong number of "%s"s.  */
-  {
-    char *yyp = *yymsg;
-    int yyi = 0;
-    while ((*yyp = *yyformat) != '\0')
-      if (*yyp == '%' && yyformat[1] == 's' && yyi < yycount)
-        {
-          yyp += yytnamerr (yyp, yyarg[yyi++]);
-          yyformat += 2;
-        }
-      else
-        {
-          ++yyp;
-          ++yyformat;
-        }
-  }
-  return 0;
-}
-#endif /* YYERROR_VERBOSE */
 
 /*-----------------------------------------------.
 | Release the memory associated to this symbol.  |
 `-----------------------------------------------*/
 
 static void
-yydestruct (const char *yymsg, int yytype, YYSTYPE *yyvaluep, YYLTYPE *yylocationp)
+yydestruct (const char *yymsg,
+            yysymbol_kind_t yykind, YYSTYPE *yyvaluep, YYLTYPE *yylocationp)
 {
-  YYUSE (yyvaluep);
-  YYUSE (yylocationp);
+  YY_USE (yyvaluep);
+  YY_USE (yylocationp);
   if (!yymsg)
     yymsg = "Deleting";
-  YY_SYMBOL_PRINT (yymsg, yytype, yyvaluep, yylocationp);
+  YY_SYMBOL_PRINT (yymsg, yykind, yyvaluep, yylocationp);
 
   YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
-  YYUSE (yytype);
+  YY_USE (yykind);
   YY_IGNORE_MAYBE_UNINITIALIZED_END
 }
 
 
-
-
-/* The lookahead symbol.  */
+/* Lookahead token kind.  */
 int yychar;
 
 /* The semantic value of the lookahead symbol.  */
@@ -1265,6 +1083,8 @@ YYLTYPE yylloc
 int yynerrs;
 
 
+
+
 /*----------.
 | yyparse.  |
 `----------*/
@@ -1272,53 +1092,45 @@ int yynerrs;
 int
 yyparse (void)
 {
-    yy_state_fast_t yystate;
+    yy_state_fast_t yystate = 0;
     /* Number of tokens to shift before error messages enabled.  */
-    int yyerrstatus;
-
-    /* The stacks and their tools:
-       'yyss': related to states.
-       'yyvs': related to semantic values.
-       'yyls': related to locations.
+    int yyerrstatus = 0;
 
-       Refer to the stacks through separate pointers, to allow yyoverflow
+    /* Refer to the stacks through separate pointers, to allow yyoverflow
        to reallocate them elsewhere.  */
 
-    /* The state stack.  */
+    /* Their size.  */
+    YYPTRDIFF_T yystacksize = YYINITDEPTH;
+
+    /* The state stack: array, bottom, top.  */
     yy_state_t yyssa[YYINITDEPTH];
-    yy_state_t *yyss;
-    yy_state_t *yyssp;
+    yy_state_t *yyss = yyssa;
+    yy_state_t *yyssp = yyss;
 
-    /* The semantic value stack.  */
+    /* The semantic value stack: array, bottom, top.  */
     YYSTYPE yyvsa[YYINITDEPTH];
-    YYSTYPE *yyvs;
-    YYSTYPE *yyvsp;
+    YYSTYPE *yyvs = yyvsa;
+    YYSTYPE *yyvsp = yyvs;
 
-    /* The location stack.  */
+    /* The location stack: array, bottom, top.  */
     YYLTYPE yylsa[YYINITDEPTH];
-    YYLTYPE *yyls;
-    YYLTYPE *yylsp;
-
-    /* The locations where the error started and ended.  */
-    YYLTYPE yyerror_range[3];
-
-    YYPTRDIFF_T yystacksize;
+    YYLTYPE *yyls = yylsa;
+    YYLTYPE *yylsp = yyls;
 
   int yyn;
+  /* The return value of yyparse.  */
   int yyresult;
-  /* Lookahead token as an internal (translated) token number.  */
-  int yytoken = 0;
+  /* Lookahead symbol kind.  */
+  yysymbol_kind_t yytoken = YYSYMBOL_YYEMPTY;
   /* The variables used to return semantic value and location from the
      action routines.  */
   YYSTYPE yyval;
   YYLTYPE yyloc;
 
-#if YYERROR_VERBOSE
-  /* Buffer for error messages, and its allocated size.  */
-  char yymsgbuf[128];
-  char *yymsg = yymsgbuf;
-  YYPTRDIFF_T yymsg_alloc = sizeof yymsgbuf;
-#endif
+  /* The locations where the error started and ended.  */
+  YYLTYPE yyerror_range[3];
+
+
 
 #define YYPOPSTACK(N)   (yyvsp -= (N), yyssp -= (N), yylsp -= (N))
 
@@ -1326,17 +1138,10 @@ yyparse (void)
      Keep to zero when no symbol should be popped.  */
   int yylen = 0;
 
-  yyssp = yyss = yyssa;
-  yyvsp = yyvs = yyvsa;
-  yylsp = yyls = yylsa;
-  yystacksize = YYINITDEPTH;
-
   YYDPRINTF ((stderr, "Starting parse\n"));
 
-  yystate = 0;
-  yyerrstatus = 0;
-  yynerrs = 0;
   yychar = YYEMPTY; /* Cause a token to be read.  */
+
   yylsp[0] = yylloc;
   goto yysetstate;
 
@@ -1359,10 +1164,11 @@ yysetstate:
   YY_IGNORE_USELESS_CAST_BEGIN
   *yyssp = YY_CAST (yy_state_t, yystate);
   YY_IGNORE_USELESS_CAST_END
+  YY_STACK_PRINT (yyss, yyssp);
 
   if (yyss + yystacksize - 1 <= yyssp)
 #if !defined yyoverflow && !defined YYSTACK_RELOCATE
-    goto yyexhaustedlab;
+    YYNOMEM;
 #else
     {
       /* Get the current used size of the three stacks, in elements.  */
@@ -1393,7 +1199,7 @@ yysetstate:
 # else /* defined YYSTACK_RELOCATE */
       /* Extend the stack our own way.  */
       if (YYMAXDEPTH <= yystacksize)
-        goto yyexhaustedlab;
+        YYNOMEM;
       yystacksize *= 2;
       if (YYMAXDEPTH < yystacksize)
         yystacksize = YYMAXDEPTH;
@@ -1404,11 +1210,11 @@ yysetstate:
           YY_CAST (union yyalloc *,
                    YYSTACK_ALLOC (YY_CAST (YYSIZE_T, YYSTACK_BYTES (yystacksize))));
         if (! yyptr)
-          goto yyexhaustedlab;
+          YYNOMEM;
         YYSTACK_RELOCATE (yyss_alloc, yyss);
         YYSTACK_RELOCATE (yyvs_alloc, yyvs);
         YYSTACK_RELOCATE (yyls_alloc, yyls);
-# undef YYSTACK_RELOCATE
+#  undef YYSTACK_RELOCATE
         if (yyss1 != yyssa)
           YYSTACK_FREE (yyss1);
       }
@@ -1428,6 +1234,7 @@ yysetstate:
     }
 #endif /* !defined yyoverflow && !defined YYSTACK_RELOCATE */
 
+
   if (yystate == YYFINAL)
     YYACCEPT;
 
@@ -1448,18 +1255,30 @@ yybackup:
 
   /* Not known => get a lookahead token if don't already have one.  */
 
-  /* YYCHAR is either YYEMPTY or YYEOF or a valid lookahead symbol.  */
+  /* YYCHAR is either empty, or end-of-input, or a valid lookahead.  */
   if (yychar == YYEMPTY)
     {
-      YYDPRINTF ((stderr, "Reading a token: "));
+      YYDPRINTF ((stderr, "Reading a token\n"));
       yychar = yylex ();
     }
 
   if (yychar <= YYEOF)
     {
-      yychar = yytoken = YYEOF;
+      yychar = YYEOF;
+      yytoken = YYSYMBOL_YYEOF;
       YYDPRINTF ((stderr, "Now at end of input.\n"));
     }
+  else if (yychar == YYerror)
+    {
+      /* The scanner already issued an error message, process directly
+         to error recovery.  But do not keep the error token as
+         lookahead, it is too special and may lead us to an endless
+         loop in error recovery. */
+      yychar = YYUNDEF;
+      yytoken = YYSYMBOL_YYerror;
+      yyerror_range[1] = yylloc;
+      goto yyerrlab1;
+    }
   else
     {
       yytoken = YYTRANSLATE (yychar);
@@ -1531,457 +1350,458 @@ yyreduce:
   YY_REDUCE_PRINT (yyn);
   switch (yyn)
     {
-  case 2:
-#line 62 "goianinha.y"
+  case 2: /* Programa: DeclFuncVar DeclProg  */
+#line 94 "goianinha.y"
         {
-            (yyval.ast) = ast_cria_com_filhos(AST_PROGRAMA,NULL,(yylsp[-1]).first_line,2,(yyvsp[-1].ast),(yyvsp[0].ast));
+            AST *globais = lista_finaliza((yyvsp[-1].lista),AST_LISTA_DECL_VAR);
+            (yyval.ast) = ast_cria_com_filhos(AST_PROGRAMA,NULL,(yylsp[-1]).first_line,2,globais,(yyvsp[0].ast));
             arvore_raiz = (yyval.ast);
         }
-#line 1541 "goianinha.tab.c"
+#line 1361 "goianinha.tab.c"
     break;
 
-  case 3:
-#line 74 "goianinha.y"
-        { (yyval.ast) = ast_cria(AST_LISTA_DECL_VAR,NULL,yylineno); }
-#line 1547 "goianinha.tab.c"
+  case 3: /* DeclFuncVar: %empty  */
+#line 107 "goianinha.y"
+        { (yyval.lista) = lista_nova(yylineno); }
+#line 1367 "goianinha.tab.c"
     break;
 
-  case 4:
-#line 78 "goianinha.y"
+  case 4: /* DeclFuncVar: DeclFuncVar Tipo ID DeclVar ';'  */
+#line 111 "goianinha.y"
     {
         /* primeiro id */
-        AST *var0 = ast_cria(AST_DECL_VARIAVEL, (yyvsp[-2].sval), (yylsp[-2]).first_line);
-        ast_adiciona_filho(var0, (yyvsp[-3].ast));   /* usa o nó $2 original */
-
-        AST *lista = (yyvsp[-4].ast) ? (yyvsp[-4].ast) : ast_cria(AST_LISTA_DECL_VAR, NULL, (yylsp[-2]).first_line);
-        ast_adiciona_filho(lista, var0);
+        AST *var0 = ast_cria_com_filhos(AST_DECL_VARIAVEL, (yyvsp[-2].sval), (yylsp[-2]).first_line, 1, (yyvsp[-3].ast));
+        lista_adiciona((yyvsp[-4].lista), var0);       /* usa o nó $2 original */
 
         /* demais ids vindos de DeclVar */
-        if ((yyvsp[-1].ast))
-            for (int i = 0; i < (yyvsp[-1].ast)->n_filhos; ++i) {
-                AST *v = (yyvsp[-1].ast)->filhos[i];
-                /* ---- CÓPIA do nó de tipo ---- */
-                AST *tipo_copia = ast_cria((yyvsp[-3].ast)->tipo, (yyvsp[-3].ast)->valor, (yyvsp[-3].ast)->linha);
-                ast_adiciona_filho(v, tipo_copia);
-                ast_adiciona_filho(lista, v);
-            }
-        (yyval.ast) = lista;
+        for (int i = 0; i < (yyvsp[-1].lista)->n; ++i) {
+            AST *v = (yyvsp[-1].lista)->itens[i];
+            /* ---- CÓPIA do nó de tipo ---- */
+            AST *tipo_copia = ast_cria((yyvsp[-3].ast)->tipo, (yyvsp[-3].ast)->valor, (yyvsp[-3].ast)->linha);
+            ast_adiciona_filho(v, tipo_copia);
+            lista_adiciona((yyvsp[-4].lista), v);
+        }
+        lista_descarta((yyvsp[-1].lista));
+        (yyval.lista) = (yyvsp[-4].lista);
     }
-#line 1571 "goianinha.tab.c"
+#line 1388 "goianinha.tab.c"
     break;
 
-  case 5:
-#line 100 "goianinha.y"
+  case 5: /* DeclFuncVar: DeclFuncVar Tipo ID DeclFunc  */
+#line 130 "goianinha.y"
         {
-            AST *func = ast_cria(AST_DECL_FUNCAO,(yyvsp[-1].sval),(yylsp[-1]).first_line);
-            ast_adiciona_filho(func,(yyvsp[-2].ast));      /* tipo retorno */
-            ast_adiciona_filho(func,(yyvsp[0].ast));      /* corpo        */
-
-            AST *lista = (yyvsp[-3].ast) ? (yyvsp[-3].ast) : ast_cria(AST_LISTA_DECL_VAR,NULL,(yylsp[-3]).first_line);
-            ast_adiciona_filho(lista,func);
-            (yyval.ast) = lista;
+            /* filhos: tipo de retorno, corpo */
+            AST *func = ast_cria_com_filhos(AST_DECL_FUNCAO,(yyvsp[-1].sval),(yylsp[-1]).first_line,2,(yyvsp[-2].ast),(yyvsp[0].ast));
+            lista_adiciona((yyvsp[-3].lista),func);
+            (yyval.lista) = (yyvsp[-3].lista);
         }
-#line 1585 "goianinha.tab.c"
+#line 1399 "goianinha.tab.c"
     break;
 
-  case 6:
-#line 114 "goianinha.y"
+  case 6: /* DeclFunc: '(' ListaParametros ')' Bloco  */
+#line 141 "goianinha.y"
         { (yyval.ast) = ast_cria_com_filhos(AST_FUNCAO,NULL,(yylsp[-3]).first_line,2,(yyvsp[-2].ast),(yyvsp[0].ast)); }
-#line 1591 "goianinha.tab.c"
+#line 1405 "goianinha.tab.c"
     break;
 
-  case 7:
-#line 122 "goianinha.y"
-        { (yyval.ast) = ast_cria(AST_LISTA_DECL_VAR,NULL,yylineno); }
-#line 1597 "goianinha.tab.c"
+  case 7: /* ListaDeclVar: %empty  */
+#line 149 "goianinha.y"
+        { (yyval.lista) = lista_nova(yylineno); }
+#line 1411 "goianinha.tab.c"
     break;
 
-  case 8:
-#line 125 "goianinha.y"
+  case 8: /* ListaDeclVar: ListaDeclVar Tipo ID DeclVar ';'  */
+#line 152 "goianinha.y"
     {
-        AST *var0 = ast_cria(AST_DECL_VARIAVEL,(yyvsp[-2].sval),(yylsp[-2]).first_line);
-        ast_adiciona_filho(var0,(yyvsp[-3].ast));
-
-        AST *lista = (yyvsp[-4].ast) ? (yyvsp[-4].ast) : ast_cria(AST_LISTA_DECL_VAR,NULL,(yylsp[-2]).first_line);
-        ast_adiciona_filho(lista,var0);
-
-        if ((yyvsp[-1].ast))
-            for (int i=0;i<(yyvsp[-1].ast)->n_filhos;++i){
-                AST *v = (yyvsp[-1].ast)->filhos[i];
-                AST *tipo_copia = ast_cria((yyvsp[-3].ast)->tipo,(yyvsp[-3].ast)->valor,(yyvsp[-3].ast)->linha);
-                ast_adiciona_filho(v,tipo_copia);
-                ast_adiciona_filho(lista,v);
-            }
-        (yyval.ast) = lista;
+        AST *var0 = ast_cria_com_filhos(AST_DECL_VARIAVEL,(yyvsp[-2].sval),(yylsp[-2]).first_line,1,(yyvsp[-3].ast));
+        lista_adiciona((yyvsp[-4].lista),var0);
+
+        for (int i=0;i<(yyvsp[-1].lista)->n;++i){
+            AST *v = (yyvsp[-1].lista)->itens[i];
+            AST *tipo_copia = ast_cria((yyvsp[-3].ast)->tipo,(yyvsp[-3].ast)->valor,(yyvsp[-3].ast)->linha);
+            ast_adiciona_filho(v,tipo_copia);
+            lista_adiciona((yyvsp[-4].lista),v);
+        }
+        lista_descarta((yyvsp[-1].lista));
+        (yyval.lista) = (yyvsp[-4].lista);
     }
-#line 1618 "goianinha.tab.c"
+#line 1429 "goianinha.tab.c"
     break;
 
-  case 9:
-#line 145 "goianinha.y"
-        { (yyval.ast) = ast_cria(AST_LISTA_DECL_VAR, NULL, yylineno); }
-#line 1624 "goianinha.tab.c"
+  case 9: /* DeclVar: %empty  */
+#line 170 "goianinha.y"
+        { (yyval.lista) = lista_nova(yylineno); }
+#line 1435 "goianinha.tab.c"
     break;
 
-  case 10:
-#line 148 "goianinha.y"
+  case 10: /* DeclVar: DeclVar ',' ID  */
+#line 173 "goianinha.y"
         {
-            AST *var = ast_cria(AST_DECL_VARIAVEL, (yyvsp[-1].sval), (yylsp[-1]).first_line);
-            AST *lista = (yyvsp[0].ast) ? (yyvsp[0].ast) : ast_cria(AST_LISTA_DECL_VAR, NULL, (yylsp[-1]).first_line);
-            ast_adiciona_filho(lista, var);
-            (yyval.ast) = lista;
+            lista_adiciona((yyvsp[-2].lista), ast_cria(AST_DECL_VARIAVEL, (yyvsp[0].sval), (yylsp[0]).first_line));
+            (yyval.lista) = (yyvsp[-2].lista);
         }
-#line 1635 "goianinha.tab.c"
+#line 1444 "goianinha.tab.c"
     break;
 
-  case 11:
-#line 159 "goianinha.y"
+  case 11: /* Bloco: '{' ListaDeclVar ListaComando '}'  */
+#line 182 "goianinha.y"
         {
-            (yyval.ast) = ast_cria_com_filhos(AST_BLOCO,NULL,(yylsp[-3]).first_line,2,(yyvsp[-2].ast),(yyvsp[-1].ast));
+            AST *decls = lista_finaliza((yyvsp[-2].lista),AST_LISTA_DECL_VAR);
+            AST *cmds  = lista_finaliza((yyvsp[-1].lista),AST_LISTA_COMANDO);
+            (yyval.ast) = ast_cria_com_filhos(AST_BLOCO,NULL,(yylsp[-3]).first_line,2,decls,cmds);
         }
-#line 1643 "goianinha.tab.c"
+#line 1454 "goianinha.tab.c"
     break;
 
-  case 12:
-#line 167 "goianinha.y"
-        { (yyval.ast) = ast_cria(AST_LISTA_COMANDO,NULL,yylineno); }
-#line 1649 "goianinha.tab.c"
+  case 12: /* ListaComando: %empty  */
+#line 192 "goianinha.y"
+        { (yyval.lista) = lista_nova(yylineno); }
+#line 1460 "goianinha.tab.c"
     break;
 
-  case 13:
-#line 170 "goianinha.y"
+  case 13: /* ListaComando: ListaComando Comando  */
+#line 195 "goianinha.y"
         {
-            AST *lista = (yyvsp[-1].ast) ? (yyvsp[-1].ast) : ast_cria(AST_LISTA_COMANDO,NULL,(yylsp[0]).first_line);
-            ast_adiciona_filho(lista,(yyvsp[0].ast));
-            (yyval.ast) = lista;
+            lista_adiciona((yyvsp[-1].lista),(yyvsp[0].ast));
+            (yyval.lista) = (yyvsp[-1].lista);
         }
-#line 1659 "goianinha.tab.c"
+#line 1469 "goianinha.tab.c"
     break;
 
-  case 14:
-#line 181 "goianinha.y"
-                             { (yyval.ast) = ast_cria(AST_COMANDO,";",(yylsp[0]).first_line); }
-#line 1665 "goianinha.tab.c"
+  case 14: /* Comando: ';'  */
+#line 205 "goianinha.y"
+                             { (yyval.ast) = ast_cria(AST_COMANDO,intern_str(";"),(yylsp[0]).first_line); }
+#line 1475 "goianinha.tab.c"
     break;
 
-  case 15:
-#line 183 "goianinha.y"
+  case 15: /* Comando: Expr ';'  */
+#line 207 "goianinha.y"
                              { (yyval.ast) = (yyvsp[-1].ast); }
-#line 1671 "goianinha.tab.c"
+#line 1481 "goianinha.tab.c"
     break;
 
-  case 16:
-#line 186 "goianinha.y"
+  case 16: /* Comando: RETORNE Expr ';'  */
+#line 210 "goianinha.y"
         { (yyval.ast) = ast_cria_com_filhos(AST_RETORNE,NULL,(yylsp[-2]).first_line,1,(yyvsp[-1].ast)); }
-#line 1677 "goianinha.tab.c"
+#line 1487 "goianinha.tab.c"
     break;
 
-  case 17:
-#line 189 "goianinha.y"
+  case 17: /* Comando: LEIA ID ';'  */
+#line 213 "goianinha.y"
         {
             AST *id = ast_cria(AST_ID,(yyvsp[-1].sval),(yylsp[-1]).first_line);
             (yyval.ast) = ast_cria_com_filhos(AST_LEITURA,NULL,(yylsp[-2]).first_line,1,id);
         }
-#line 1686 "goianinha.tab.c"
+#line 1496 "goianinha.tab.c"
     break;
 
-  case 18:
-#line 195 "goianinha.y"
+  case 18: /* Comando: ESCREVA Expr ';'  */
+#line 219 "goianinha.y"
         { (yyval.ast) = ast_cria_com_filhos(AST_ESCRITA,NULL,(yylsp[-2]).first_line,1,(yyvsp[-1].ast)); }
-#line 1692 "goianinha.tab.c"
+#line 1502 "goianinha.tab.c"
     break;
 
-  case 19:
-#line 198 "goianinha.y"
+  case 19: /* Comando: ESCREVA STRING ';'  */
+#line 222 "goianinha.y"
         {
             AST *str = ast_cria(AST_STRING,(yyvsp[-1].sval),(yylsp[-1]).first_line);
             (yyval.ast) = ast_cria_com_filhos(AST_ESCRITA,NULL,(yylsp[-2]).first_line,1,str);
         }
-#line 1701 "goianinha.tab.c"
+#line 1511 "goianinha.tab.c"
     break;
 
-  case 20:
-#line 204 "goianinha.y"
+  case 20: /* Comando: NOVALINHA ';'  */
+#line 228 "goianinha.y"
         { (yyval.ast) = ast_cria(AST_NOVALINHA,NULL,(yylsp[-1]).first_line); }
-#line 1707 "goianinha.tab.c"
+#line 1517 "goianinha.tab.c"
     break;
 
-  case 21:
-#line 207 "goianinha.y"
+  case 21: /* Comando: SE '(' Expr ')' ENTAO Comando  */
+#line 231 "goianinha.y"
         { (yyval.ast) = ast_cria_com_filhos(AST_SE,NULL,(yylsp[-5]).first_line,2,(yyvsp[-3].ast),(yyvsp[0].ast)); }
-#line 1713 "goianinha.tab.c"
+#line 1523 "goianinha.tab.c"
     break;
 
-  case 22:
-#line 210 "goianinha.y"
+  case 22: /* Comando: SE '(' Expr ')' ENTAO Comando SENAO Comando  */
+#line 234 "goianinha.y"
         {
             AST *ifnode = ast_cria_com_filhos(AST_SE,NULL,(yylsp[-7]).first_line,2,(yyvsp[-5].ast),(yyvsp[-2].ast));
             (yyval.ast) = ast_cria_com_filhos(AST_SENAO,NULL,(yylsp[-7]).first_line,2,ifnode,(yyvsp[0].ast));
         }
-#line 1722 "goianinha.tab.c"
+#line 1532 "goianinha.tab.c"
     break;
 
-  case 23:
-#line 216 "goianinha.y"
+  case 23: /* Comando: ENQUANTO '(' Expr ')' EXECUTE Comando  */
+#line 240 "goianinha.y"
         { (yyval.ast) = ast_cria_com_filhos(AST_ENQUANTO,NULL,(yylsp[-5]).first_line,2,(yyvsp[-3].ast),(yyvsp[0].ast)); }
-#line 1728 "goianinha.tab.c"
+#line 1538 "goianinha.tab.c"
     break;
 
-  case 24:
-#line 219 "goianinha.y"
+  case 24: /* Comando: Bloco  */
+#line 243 "goianinha.y"
         { (yyval.ast) = (yyvsp[0].ast); }
-#line 1734 "goianinha.tab.c"
+#line 1544 "goianinha.tab.c"
     break;
 
-  case 25:
-#line 227 "goianinha.y"
+  case 25: /* Expr: OrExpr  */
+#line 251 "goianinha.y"
         { (yyval.ast) = (yyvsp[0].ast); }
-#line 1740 "goianinha.tab.c"
+#line 1550 "goianinha.tab.c"
     break;
 
-  case 26:
-#line 230 "goianinha.y"
+  case 26: /* Expr: ID '=' Expr  */
+#line 254 "goianinha.y"
         {
             AST *id = ast_cria(AST_ID,(yyvsp[-2].sval),(yylsp[-2]).first_line);
-            (yyval.ast) = ast_cria_com_filhos(AST_ATRIB,"=",(yylsp[-1]).first_line,2,id,(yyvsp[0].ast));
+            (yyval.ast) = ast_cria_com_filhos(AST_ATRIB,intern_str("="),(yylsp[-1]).first_line,2,id,(yyvsp[0].ast));
         }
-#line 1749 "goianinha.tab.c"
+#line 1559 "goianinha.tab.c"
     break;
 
-  case 27:
-#line 238 "goianinha.y"
-        { (yyval.ast) = ast_cria_com_filhos(AST_OP,"ou",(yylsp[-1]).first_line,2,(yyvsp[-2].ast),(yyvsp[0].ast)); }
-#line 1755 "goianinha.tab.c"
+  case 27: /* OrExpr: OrExpr OU AndExpr  */
+#line 262 "goianinha.y"
+        { (yyval.ast) = ast_cria_op(OP_OU,(yylsp[-1]).first_line,(yyvsp[-2].ast),(yyvsp[0].ast)); }
+#line 1565 "goianinha.tab.c"
     break;
 
-  case 28:
-#line 240 "goianinha.y"
+  case 28: /* OrExpr: AndExpr  */
+#line 264 "goianinha.y"
         { (yyval.ast) = (yyvsp[0].ast); }
-#line 1761 "goianinha.tab.c"
+#line 1571 "goianinha.tab.c"
     break;
 
-  case 29:
-#line 245 "goianinha.y"
-        { (yyval.ast) = ast_cria_com_filhos(AST_OP,"e",(yylsp[-1]).first_line,2,(yyvsp[-2].ast),(yyvsp[0].ast)); }
-#line 1767 "goianinha.tab.c"
+  case 29: /* AndExpr: AndExpr E EqExpr  */
+#line 269 "goianinha.y"
+        { (yyval.ast) = ast_cria_op(OP_E,(yylsp[-1]).first_line,(yyvsp[-2].ast),(yyvsp[0].ast)); }
+#line 1577 "goianinha.tab.c"
     break;
 
-  case 30:
-#line 247 "goianinha.y"
+  case 30: /* AndExpr: EqExpr  */
+#line 271 "goianinha.y"
         { (yyval.ast) = (yyvsp[0].ast); }
-#line 1773 "goianinha.tab.c"
+#line 1583 "goianinha.tab.c"
     break;
 
-  case 31:
-#line 251 "goianinha.y"
-                             { (yyval.ast) = ast_cria_com_filhos(AST_OP,"==",(yylsp[-1]).first_line,2,(yyvsp[-2].ast),(yyvsp[0].ast)); }
-#line 1779 "goianinha.tab.c"
+  case 31: /* EqExpr: EqExpr EQ DesigExpr  */
+#line 275 "goianinha.y"
+                             { (yyval.ast) = ast_cria_op(OP_IGUAL,(yylsp[-1]).first_line,(yyvsp[-2].ast),(yyvsp[0].ast)); }
+#line 1589 "goianinha.tab.c"
     break;
 
-  case 32:
-#line 252 "goianinha.y"
-                             { (yyval.ast) = ast_cria_com_filhos(AST_OP,"!=",(yylsp[-1]).first_line,2,(yyvsp[-2].ast),(yyvsp[0].ast)); }
-#line 1785 "goianinha.tab.c"
+  case 32: /* EqExpr: EqExpr NEQ DesigExpr  */
+#line 276 "goianinha.y"
+                             { (yyval.ast) = ast_cria_op(OP_DIFERENTE,(yylsp[-1]).first_line,(yyvsp[-2].ast),(yyvsp[0].ast)); }
+#line 1595 "goianinha.tab.c"
     break;
 
-  case 33:
-#line 253 "goianinha.y"
+  case 33: /* EqExpr: DesigExpr  */
+#line 277 "goianinha.y"
                              { (yyval.ast) = (yyvsp[0].ast); }
-#line 1791 "goianinha.tab.c"
+#line 1601 "goianinha.tab.c"
     break;
 
-  case 34:
-#line 257 "goianinha.y"
-                             { (yyval.ast) = ast_cria_com_filhos(AST_OP,"<",(yylsp[-1]).first_line,2,(yyvsp[-2].ast),(yyvsp[0].ast)); }
-#line 1797 "goianinha.tab.c"
+  case 34: /* DesigExpr: DesigExpr '<' AddExpr  */
+#line 281 "goianinha.y"
+                             { (yyval.ast) = ast_cria_op(OP_MENOR,(yylsp[-1]).first_line,(yyvsp[-2].ast),(yyvsp[0].ast)); }
+#line 1607 "goianinha.tab.c"
     break;
 
-  case 35:
-#line 258 "goianinha.y"
-                             { (yyval.ast) = ast_cria_com_filhos(AST_OP,">",(yylsp[-1]).first_line,2,(yyvsp[-2].ast),(yyvsp[0].ast)); }
-#line 1803 "goianinha.tab.c"
+  case 35: /* DesigExpr: DesigExpr '>' AddExpr  */
+#line 282 "goianinha.y"
+                             { (yyval.ast) = ast_cria_op(OP_MAIOR,(yylsp[-1]).first_line,(yyvsp[-2].ast),(yyvsp[0].ast)); }
+#line 1613 "goianinha.tab.c"
     break;
 
-  case 36:
-#line 259 "goianinha.y"
-                             { (yyval.ast) = ast_cria_com_filhos(AST_OP,"<=",(yylsp[-1]).first_line,2,(yyvsp[-2].ast),(yyvsp[0].ast)); }
-#line 1809 "goianinha.tab.c"
+  case 36: /* DesigExpr: DesigExpr LEQ AddExpr  */
+#line 283 "goianinha.y"
+                             { (yyval.ast) = ast_cria_op(OP_MENOR_IGUAL,(yylsp[-1]).first_line,(yyvsp[-2].ast),(yyvsp[0].ast)); }
+#line 1619 "goianinha.tab.c"
     break;
 
-  case 37:
-#line 260 "goianinha.y"
-                             { (yyval.ast) = ast_cria_com_filhos(AST_OP,">=",(yylsp[-1]).first_line,2,(yyvsp[-2].ast),(yyvsp[0].ast)); }
-#line 1815 "goianinha.tab.c"
+  case 37: /* DesigExpr: DesigExpr GEQ AddExpr  */
+#line 284 "goianinha.y"
+                             { (yyval.ast) = ast_cria_op(OP_MAIOR_IGUAL,(yylsp[-1]).first_line,(yyvsp[-2].ast),(yyvsp[0].ast)); }
+#line 1625 "goianinha.tab.c"
     break;
 
-  case 38:
-#line 261 "goianinha.y"
+  case 38: /* DesigExpr: AddExpr  */
+#line 285 "goianinha.y"
                             { (yyval.ast) = (yyvsp[0].ast); }
-#line 1821 "goianinha.tab.c"
+#line 1631 "goianinha.tab.c"
     break;
 
-  case 39:
-#line 265 "goianinha.y"
-                            { (yyval.ast) = ast_cria_com_filhos(AST_OP,"+",(yylsp[-1]).first_line,2,(yyvsp[-2].ast),(yyvsp[0].ast)); }
-#line 1827 "goianinha.tab.c"
+  case 39: /* AddExpr: AddExpr '+' MulExpr  */
+#line 289 "goianinha.y"
+                            { (yyval.ast) = ast_cria_op(OP_SOMA,(yylsp[-1]).first_line,(yyvsp[-2].ast),(yyvsp[0].ast)); }
+#line 1637 "goianinha.tab.c"
     break;
 
-  case 40:
-#line 266 "goianinha.y"
-                            { (yyval.ast) = ast_cria_com_filhos(AST_OP,"-",(yylsp[-1]).first_line,2,(yyvsp[-2].ast),(yyvsp[0].ast)); }
-#line 1833 "goianinha.tab.c"
+  case 40: /* AddExpr: AddExpr '-' MulExpr  */
+#line 290 "goianinha.y"
+                            { (yyval.ast) = ast_cria_op(OP_SUB,(yylsp[-1]).first_line,(yyvsp[-2].ast),(yyvsp[0].ast)); }
+#line 1643 "goianinha.tab.c"
     break;
 
-  case 41:
-#line 267 "goianinha.y"
+  case 41: /* AddExpr: MulExpr  */
+#line 291 "goianinha.y"
                             { (yyval.ast) = (yyvsp[0].ast); }
-#line 1839 "goianinha.tab.c"
+#line 1649 "goianinha.tab.c"
     break;
 
-  case 42:
-#line 271 "goianinha.y"
-                            { (yyval.ast) = ast_cria_com_filhos(AST_OP,"*",(yylsp[-1]).first_line,2,(yyvsp[-2].ast),(yyvsp[0].ast)); }
-#line 1845 "goianinha.tab.c"
+  case 42: /* MulExpr: MulExpr '*' UnExpr  */
+#line 295 "goianinha.y"
+                            { (yyval.ast) = ast_cria_op(OP_MUL,(yylsp[-1]).first_line,(yyvsp[-2].ast),(yyvsp[0].ast)); }
+#line 1655 "goianinha.tab.c"
     break;
 
-  case 43:
-#line 272 "goianinha.y"
-                            { (yyval.ast) = ast_cria_com_filhos(AST_OP,"/",(yylsp[-1]).first_line,2,(yyvsp[-2].ast),(yyvsp[0].ast)); }
-#line 1851 "goianinha.tab.c"
+  case 43: /* MulExpr: MulExpr '/' UnExpr  */
+#line 296 "goianinha.y"
+                            { (yyval.ast) = ast_cria_op(OP_DIV,(yylsp[-1]).first_line,(yyvsp[-2].ast),(yyvsp[0].ast)); }
+#line 1661 "goianinha.tab.c"
     break;
 
-  case 44:
-#line 273 "goianinha.y"
+  case 44: /* MulExpr: UnExpr  */
+#line 297 "goianinha.y"
                             { (yyval.ast) = (yyvsp[0].ast); }
-#line 1857 "goianinha.tab.c"
+#line 1667 "goianinha.tab.c"
     break;
 
-  case 45:
-#line 277 "goianinha.y"
-                                { (yyval.ast) = ast_cria_com_filhos(AST_OP,"uminus",(yylsp[-1]).first_line,1,(yyvsp[0].ast)); }
-#line 1863 "goianinha.tab.c"
+  case 45: /* UnExpr: '-' UnExpr  */
+#line 301 "goianinha.y"
+                                { (yyval.ast) = ast_cria_op(OP_NEG,(yylsp[-1]).first_line,(yyvsp[0].ast),NULL); }
+#line 1673 "goianinha.tab.c"
     break;
 
-  case 46:
-#line 278 "goianinha.y"
-                                { (yyval.ast) = ast_cria_com_filhos(AST_OP,"!",(yylsp[-1]).first_line,1,(yyvsp[0].ast)); }
-#line 1869 "goianinha.tab.c"
+  case 46: /* UnExpr: '!' UnExpr  */
+#line 302 "goianinha.y"
+                                { (yyval.ast) = ast_cria_op(OP_NAO,(yylsp[-1]).first_line,(yyvsp[0].ast),NULL); }
+#line 1679 "goianinha.tab.c"
     break;
 
-  case 47:
-#line 279 "goianinha.y"
+  case 47: /* UnExpr: PrimExpr  */
+#line 303 "goianinha.y"
                                 { (yyval.ast) = (yyvsp[0].ast); }
-#line 1875 "goianinha.tab.c"
+#line 1685 "goianinha.tab.c"
     break;
 
-  case 48:
-#line 284 "goianinha.y"
+  case 48: /* PrimExpr: ID '(' ListExpr ')'  */
+#line 308 "goianinha.y"
         {
-            AST *call = ast_cria(AST_CHAMADA_FUNCAO,(yyvsp[-3].sval),(yylsp[-3]).first_line);
-            if ((yyvsp[-1].ast)) ast_adiciona_filho(call,(yyvsp[-1].ast));
-            (yyval.ast) = call;
+            AST *args = lista_finaliza((yyvsp[-1].lista),AST_LISTA_EXPR);
+            (yyval.ast) = ast_cria_com_filhos(AST_CHAMADA_FUNCAO,(yyvsp[-3].sval),(yylsp[-3]).first_line,1,args);
         }
-#line 1885 "goianinha.tab.c"
+#line 1694 "goianinha.tab.c"
     break;
 
-  case 49:
-#line 289 "goianinha.y"
+  case 49: /* PrimExpr: ID '(' ')'  */
+#line 312 "goianinha.y"
                                 { (yyval.ast) = ast_cria(AST_CHAMADA_FUNCAO,(yyvsp[-2].sval),(yylsp[-2]).first_line); }
-#line 1891 "goianinha.tab.c"
+#line 1700 "goianinha.tab.c"
     break;
 
-  case 50:
-#line 290 "goianinha.y"
+  case 50: /* PrimExpr: ID  */
+#line 313 "goianinha.y"
                                 { (yyval.ast) = ast_cria(AST_ID,(yyvsp[0].sval),(yylsp[0]).first_line); }
-#line 1897 "goianinha.tab.c"
+#line 1706 "goianinha.tab.c"
     break;
 
-  case 51:
-#line 291 "goianinha.y"
+  case 51: /* PrimExpr: CARCONST  */
+#line 314 "goianinha.y"
                                 { (yyval.ast) = ast_cria(AST_CAR,(yyvsp[0].sval),(yylsp[0]).first_line); }
-#line 1903 "goianinha.tab.c"
+#line 1712 "goianinha.tab.c"
     break;
 
-  case 52:
-#line 292 "goianinha.y"
-                                { (yyval.ast) = ast_cria(AST_INT,(yyvsp[0].sval),(yylsp[0]).first_line); }
-#line 1909 "goianinha.tab.c"
+  case 52: /* PrimExpr: INTCONST  */
+#line 316 "goianinha.y"
+        {
+            if (!inteiro_cabe((yyvsp[0].sval))) {
+                fprintf(stderr, "ERRO: constante inteira fora do intervalo linha %d\n",
+                        (yylsp[0]).first_line);
+                YYABORT;
+            }
+            (yyval.ast) = ast_cria(AST_INT,(yyvsp[0].sval),(yylsp[0]).first_line);
+        }
+#line 1725 "goianinha.tab.c"
     break;
 
-  case 53:
-#line 293 "goianinha.y"
+  case 53: /* PrimExpr: '(' Expr ')'  */
+#line 324 "goianinha.y"
                                 { (yyval.ast) = (yyvsp[-1].ast); }
-#line 1915 "goianinha.tab.c"
+#line 1731 "goianinha.tab.c"
     break;
 
-  case 54:
-#line 298 "goianinha.y"
-        { (yyval.ast) = ast_cria_com_filhos(AST_LISTA_EXPR,NULL,(yylsp[0]).first_line,1,(yyvsp[0].ast)); }
-#line 1921 "goianinha.tab.c"
+  case 54: /* ListExpr: Expr  */
+#line 329 "goianinha.y"
+        {
+            (yyval.lista) = lista_nova((yylsp[0]).first_line);
+            lista_adiciona((yyval.lista),(yyvsp[0].ast));
+        }
+#line 1740 "goianinha.tab.c"
     break;
 
-  case 55:
-#line 300 "goianinha.y"
+  case 55: /* ListExpr: ListExpr ',' Expr  */
+#line 334 "goianinha.y"
         {
-            (yyval.ast) = (yyvsp[-2].ast);
-            ast_adiciona_filho((yyval.ast),(yyvsp[0].ast));
+            lista_adiciona((yyvsp[-2].lista),(yyvsp[0].ast));
+            (yyval.lista) = (yyvsp[-2].lista);
         }
-#line 1930 "goianinha.tab.c"
+#line 1749 "goianinha.tab.c"
     break;
 
-  case 56:
-#line 310 "goianinha.y"
-            { (yyval.ast) = ast_cria(AST_INT,"int",(yylsp[0]).first_line); }
-#line 1936 "goianinha.tab.c"
+  case 56: /* Tipo: INT  */
+#line 344 "goianinha.y"
+            { (yyval.ast) = ast_cria(AST_INT,intern_str("int"),(yylsp[0]).first_line); }
+#line 1755 "goianinha.tab.c"
     break;
 
-  case 57:
-#line 311 "goianinha.y"
-            { (yyval.ast) = ast_cria(AST_CAR,"car",(yylsp[0]).first_line); }
-#line 1942 "goianinha.tab.c"
+  case 57: /* Tipo: CAR  */
+#line 345 "goianinha.y"
+            { (yyval.ast) = ast_cria(AST_CAR,intern_str("car"),(yylsp[0]).first_line); }
+#line 1761 "goianinha.tab.c"
     break;
 
-  case 58:
-#line 319 "goianinha.y"
+  case 58: /* ListaParametros: %empty  */
+#line 353 "goianinha.y"
         { (yyval.ast) = ast_cria(AST_LISTA_PARAM,NULL,yylineno); }
-#line 1948 "goianinha.tab.c"
+#line 1767 "goianinha.tab.c"
     break;
 
-  case 59:
-#line 321 "goianinha.y"
-        { (yyval.ast) = (yyvsp[0].ast); }
-#line 1954 "goianinha.tab.c"
+  case 59: /* ListaParametros: ListaParametrosCont  */
+#line 355 "goianinha.y"
+        { (yyval.ast) = lista_finaliza((yyvsp[0].lista),AST_LISTA_PARAM); }
+#line 1773 "goianinha.tab.c"
     break;
 
-  case 60:
-#line 326 "goianinha.y"
+  case 60: /* ListaParametrosCont: Tipo ID  */
+#line 360 "goianinha.y"
         {
             AST *id = ast_cria(AST_ID,(yyvsp[0].sval),(yylsp[0]).first_line);
             AST *par = ast_cria_com_filhos(AST_PARAM,NULL,(yylsp[-1]).first_line,2,(yyvsp[-1].ast),id);
-            (yyval.ast) = ast_cria_com_filhos(AST_LISTA_PARAM,NULL,(yylsp[-1]).first_line,1,par);
+            (yyval.lista) = lista_nova((yylsp[-1]).first_line);
+            lista_adiciona((yyval.lista),par);
         }
-#line 1964 "goianinha.tab.c"
+#line 1784 "goianinha.tab.c"
     break;
 
-  case 61:
-#line 332 "goianinha.y"
+  case 61: /* ListaParametrosCont: ListaParametrosCont ',' Tipo ID  */
+#line 367 "goianinha.y"
         {
             AST *id = ast_cria(AST_ID,(yyvsp[0].sval),(yylsp[0]).first_line);
             AST *par = ast_cria_com_filhos(AST_PARAM,NULL,(yylsp[-1]).first_line,2,(yyvsp[-1].ast),id);
-            (yyval.ast) = (yyvsp[-3].ast);
-            ast_adiciona_filho((yyval.ast),par);
+            lista_adiciona((yyvsp[-3].lista),par);
+            (yyval.lista) = (yyvsp[-3].lista);
         }
-#line 1975 "goianinha.tab.c"
+#line 1795 "goianinha.tab.c"
     break;
 
-  case 62:
-#line 345 "goianinha.y"
-        { (yyval.ast) = ast_cria_com_filhos(AST_DECL_FUNCAO,"programa",(yylsp[-1]).first_line,1,(yyvsp[0].ast)); }
-#line 1981 "goianinha.tab.c"
+  case 62: /* DeclProg: PROGRAMA Bloco  */
+#line 380 "goianinha.y"
+        { (yyval.ast) = ast_cria_com_filhos(AST_DECL_FUNCAO,intern_str("programa"),(yylsp[-1]).first_line,1,(yyvsp[0].ast)); }
+#line 1801 "goianinha.tab.c"
     break;
 
 
-#line 1985 "goianinha.tab.c"
+#line 1805 "goianinha.tab.c"
 
       default: break;
     }
@@ -1996,11 +1816,10 @@ yyreduce:
      case of YYERROR or YYBACKUP, subsequent parser actions might lead
      to an incorrect destructor call or verbose syntax error message
      before the lookahead is translated.  */
-  YY_SYMBOL_PRINT ("-> $$ =", yyr1[yyn], &yyval, &yyloc);
+  YY_SYMBOL_PRINT ("-> $$ =", YY_CAST (yysymbol_kind_t, yyr1[yyn]), &yyval, &yyloc);
 
   YYPOPSTACK (yylen);
   yylen = 0;
-  YY_STACK_PRINT (yyss, yyssp);
 
   *++yyvsp = yyval;
   *++yylsp = yyloc;
@@ -2025,50 +1844,15 @@ yyreduce:
 yyerrlab:
   /* Make sure we have latest lookahead translation.  See comments at
      user semantic actions for why this is necessary.  */
-  yytoken = yychar == YYEMPTY ? YYEMPTY : YYTRANSLATE (yychar);
-
+  yytoken = yychar == YYEMPTY ? YYSYMBOL_YYEMPTY : YYTRANSLATE (yychar);
   /* If not already recovering from an error, report this error.  */
   if (!yyerrstatus)
     {
       ++yynerrs;
-#if ! YYERROR_VERBOSE
       yyerror (YY_("syntax error"));
-#else
-# define YYSYNTAX_ERROR yysyntax_error (&yymsg_alloc, &yymsg, \
-                                        yyssp, yytoken)
-      {
-        char const *yymsgp = YY_("syntax error");
-        int yysyntax_error_status;
-        yysyntax_error_status = YYSYNTAX_ERROR;
-        if (yysyntax_error_status == 0)
-          yymsgp = yymsg;
-        else if (yysyntax_error_status == 1)
-          {
-            if (yymsg != yymsgbuf)
-              YYSTACK_FREE (yymsg);
-            yymsg = YY_CAST (char *, YYSTACK_ALLOC (YY_CAST (YYSIZE_T, yymsg_alloc)));
-            if (!yymsg)
-              {
-                yymsg = yymsgbuf;
-                yymsg_alloc = sizeof yymsgbuf;
-                yysyntax_error_status = 2;
-              }
-            else
-              {
-                yysyntax_error_status = YYSYNTAX_ERROR;
-                yymsgp = yymsg;
-              }
-          }
-        yyerror (yymsgp);
-        if (yysyntax_error_status == 2)
-          goto yyexhaustedlab;
-      }
-# undef YYSYNTAX_ERROR
-#endif
     }
 
   yyerror_range[1] = yylloc;
-
   if (yyerrstatus == 3)
     {
       /* If just tried and failed to reuse lookahead token after an
@@ -2101,6 +1885,7 @@ yyerrorlab:
      label yyerrorlab therefore never appears in user code.  */
   if (0)
     YYERROR;
+  ++yynerrs;
 
   /* Do not reclaim the symbols of the rule whose action triggered
      this YYERROR.  */
@@ -2117,13 +1902,14 @@ yyerrorlab:
 yyerrlab1:
   yyerrstatus = 3;      /* Each real token shifted decrements this.  */
 
+  /* Pop stack until we find a state that shifts the error token.  */
   for (;;)
     {
       yyn = yypact[yystate];
       if (!yypact_value_is_default (yyn))
         {
-          yyn += YYTERROR;
-          if (0 <= yyn && yyn <= YYLAST && yycheck[yyn] == YYTERROR)
+          yyn += YYSYMBOL_YYerror;
+          if (0 <= yyn && yyn <= YYLAST && yycheck[yyn] == YYSYMBOL_YYerror)
             {
               yyn = yytable[yyn];
               if (0 < yyn)
@@ -2137,7 +1923,7 @@ yyerrlab1:
 
       yyerror_range[1] = *yylsp;
       yydestruct ("Error: popping",
-                  yystos[yystate], yyvsp, yylsp);
+                  YY_ACCESSING_SYMBOL (yystate), yyvsp, yylsp);
       YYPOPSTACK (1);
       yystate = *yyssp;
       YY_STACK_PRINT (yyss, yyssp);
@@ -2148,13 +1934,11 @@ yyerrlab1:
   YY_IGNORE_MAYBE_UNINITIALIZED_END
 
   yyerror_range[2] = yylloc;
-  /* Using YYLLOC is tempting, but would change the location of
-     the lookahead.  YYLOC is available though.  */
-  YYLLOC_DEFAULT (yyloc, yyerror_range, 2);
-  *++yylsp = yyloc;
+  ++yylsp;
+  YYLLOC_DEFAULT (*yylsp, yyerror_range, 2);
 
   /* Shift the error token.  */
-  YY_SYMBOL_PRINT ("Shifting", yystos[yyn], yyvsp, yylsp);
+  YY_SYMBOL_PRINT ("Shifting", YY_ACCESSING_SYMBOL (yyn), yyvsp, yylsp);
 
   yystate = yyn;
   goto yynewstate;
@@ -2165,7 +1949,7 @@ yyerrlab1:
 `-------------------------------------*/
 yyacceptlab:
   yyresult = 0;
-  goto yyreturn;
+  goto yyreturnlab;
 
 
 /*-----------------------------------.
@@ -2173,24 +1957,22 @@ yyacceptlab:
 `-----------------------------------*/
 yyabortlab:
   yyresult = 1;
-  goto yyreturn;
+  goto yyreturnlab;
 
 
-#if !defined yyoverflow || YYERROR_VERBOSE
-/*-------------------------------------------------.
-| yyexhaustedlab -- memory exhaustion comes here.  |
-`-------------------------------------------------*/
+/*-----------------------------------------------------------.
+| yyexhaustedlab -- YYNOMEM (memory exhaustion) comes here.  |
+`-----------------------------------------------------------*/
 yyexhaustedlab:
   yyerror (YY_("memory exhausted"));
   yyresult = 2;
-  /* Fall through.  */
-#endif
+  goto yyreturnlab;
 
 
-/*-----------------------------------------------------.
-| yyreturn -- parsing is finished, return the result.  |
-`-----------------------------------------------------*/
-yyreturn:
+/*----------------------------------------------------------.
+| yyreturnlab -- parsing is finished, clean up and return.  |
+`----------------------------------------------------------*/
+yyreturnlab:
   if (yychar != YYEMPTY)
     {
       /* Make sure we have latest lookahead translation.  See comments at
@@ -2206,20 +1988,18 @@ yyreturn:
   while (yyssp != yyss)
     {
       yydestruct ("Cleanup: popping",
-                  yystos[+*yyssp], yyvsp, yylsp);
+                  YY_ACCESSING_SYMBOL (+*yyssp), yyvsp, yylsp);
       YYPOPSTACK (1);
     }
 #ifndef yyoverflow
   if (yyss != yyssa)
     YYSTACK_FREE (yyss);
 #endif
-#if YYERROR_VERBOSE
-  if (yymsg != yymsgbuf)
-    YYSTACK_FREE (yymsg);
-#endif
+
   return yyresult;
 }
-#line 348 "goianinha.y"
+
+#line 383 "goianinha.y"
 
 
 /* Nenhum main aqui – usamos main.c separado */
@@ -1,8 +1,8 @@
-/* A Bison parser, made by GNU Bison 3.5.1.  */
+/* A Bison parser, made by GNU Bison 3.8.2.  */
 
 /* Bison interface for Yacc-like parsers in C
 
-   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2020 Free Software Foundation,
+   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2021 Free Software Foundation,
    Inc.
 
    This program is free software: you can redistribute it and/or modify
@@ -16,7 +16,7 @@
    GNU General Public License for more details.
 
    You should have received a copy of the GNU General Public License
-   along with this program.  If not, see <http://www.gnu.org/licenses/>.  */
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
 
 /* As a special exception, you may create a larger work that contains
    part or all of the Bison parser skeleton and distribute that work
@@ -31,8 +31,9 @@
    This special exception was added by the Free Software Foundation in
    version 2.2 of Bison.  */
 
-/* Undocumented macros, especially those whose name start with YY_,
-   are private implementation details.  Do not rely on them.  */
+/* DO NOT RELY ON FEATURES THAT ARE NOT DOCUMENTED in the manual,
+   especially those whose name start with YY_ or yy_.  They are
+   private implementation details that can be changed or removed.  */
 
 #ifndef YY_YY_GOIANINHA_TAB_H_INCLUDED
 # define YY_YY_GOIANINHA_TAB_H_INCLUDED
@@ -44,48 +45,54 @@
 extern int yydebug;
 #endif
 
-/* Token type.  */
+/* Token kinds.  */
 #ifndef YYTOKENTYPE
 # define YYTOKENTYPE
   enum yytokentype
   {
-    PROGRAMA = 258,
-    INT = 259,
-    CAR = 260,
-    RETORNE = 261,
-    LEIA = 262,
-    ESCREVA = 263,
-    NOVALINHA = 264,
-    SE = 265,
-    ENTAO = 266,
-    SENAO = 267,
-    ENQUANTO = 268,
-    EXECUTE = 269,
-    OU = 270,
-    E = 271,
-    EQ = 272,
-    NEQ = 273,
-    LEQ = 274,
-    GEQ = 275,
-    ID = 276,
-    INTCONST = 277,
-    CARCONST = 278,
-    STRING = 279,
-    UMINUS = 280
+    YYEMPTY = -2,
+    YYEOF = 0,                     /* "end of file"  */
+    YYerror = 256,                 /* error  */
+    YYUNDEF = 257,                 /* "invalid token"  */
+    PROGRAMA = 258,                /* PROGRAMA  */
+    INT = 259,                     /* INT  */
+    CAR = 260,                     /* CAR  */
+    RETORNE = 261,                 /* RETORNE  */
+    LEIA = 262,                    /* LEIA  */
+    ESCREVA = 263,                 /* ESCREVA  */
+    NOVALINHA = 264,               /* NOVALINHA  */
+    SE = 265,                      /* SE  */
+    ENTAO = 266,                   /* ENTAO  */
+    SENAO = 267,                   /* SENAO  */
+    ENQUANTO = 268,                /* ENQUANTO  */
+    EXECUTE = 269,                 /* EXECUTE  */
+    OU = 270,                      /* OU  */
+    E = 271,                       /* E  */
+    EQ = 272,                      /* EQ  */
+    NEQ = 273,                     /* NEQ  */
+    LEQ = 274,                     /* LEQ  */
+    GEQ = 275,                     /* GEQ  */
+    ID = 276,                      /* ID  */
+    INTCONST = 277,                /* INTCONST  */
+    CARCONST = 278,                /* CARCONST  */
+    STRING = 279,                  /* STRING  */
+    UMINUS = 280                   /* UMINUS  */
   };
+  typedef enum yytokentype yytoken_kind_t;
 #endif
 
 /* Value type.  */
 #if ! defined YYSTYPE && ! defined YYSTYPE_IS_DECLARED
 union YYSTYPE
 {
-#line 22 "goianinha.y"
+#line 49 "goianinha.y"
 
     int   ival;
-    char *sval;
+    const char *sval;   /* texto internado (intern.h) */
     AST  *ast;
+    ListaAST *lista;    /* lista ainda em construção     */
 
-#line 89 "goianinha.tab.h"
+#line 96 "goianinha.tab.h"
 
 };
 typedef union YYSTYPE YYSTYPE;
@@ -110,6 +117,8 @@ struct YYLTYPE
 
 extern YYSTYPE yylval;
 extern YYLTYPE yylloc;
+
 int yyparse (void);
 
+
 #endif /* !YY_YY_GOIANINHA_TAB_H_INCLUDED  */
@@ -3,26 +3,54 @@
  * ------------------------------------------------------------------ */
 
 %{
+    #include <errno.h>
+    #include <stdint.h>
     #include <stdio.h>
     #include <stdlib.h>
     #include "ast.h"
+    #include "intern.h"
+    #include "estatisticas.h"
+
+    /* a pilha do parser cresce no heap (dobrando) até este limite;
+       o padrão do Bison (10000) não comporta aninhamentos profundos */
+    #define YYMAXDEPTH 50000000
 
     extern int yylineno;        /* linha atual do Flex */
     int yylex(void);
     void yyerror(const char *s);
 
+    /* com -ftime-report, conta os tokens e mede o tempo do scanner */
+    static int yylex_medido(void) {
+        if (!est_ativo()) return yylex();
+        est_entra(FASE_LEXICO);
+        int t = yylex();
+        est_sai(FASE_LEXICO);
+        est_conta(FASE_LEXICO, 1);
+        return t;
+    }
+    #define yylex yylex_medido
+
     AST *arvore_raiz = NULL;    /* raiz global da AST */
 
     void yyerror(const char *s) {
         fprintf(stderr, "ERRO: %s linha %d\n", s, yylineno);
     }
+
+    /* int é de 32 bits com sinal: um literal maior que INT32_MAX não
+       tem representação (-2147483648 se escreve -2147483647 - 1) */
+    static int inteiro_cabe(const char *texto) {
+        errno = 0;
+        unsigned long v = strtoul(texto, NULL, 10);
+        return errno == 0 && v <= INT32_MAX;
+    }
 %}
 
 /* ---------- %union ---------- */
 %union {
     int   ival;
-    char *sval;
+    const char *sval;   /* texto internado (intern.h) */
     AST  *ast;
+    ListaAST *lista;    /* lista ainda em construção     */
 }
 
 /* ---------- Tokens ---------- */
@@ -46,13 +74,17 @@
 %right UMINUS '!'
 
 /* ---------- Tipagem de não‐terminais ---------- */
-%type <ast> Programa DeclFuncVar DeclFunc DeclProg
-%type <ast> ListaDeclVar DeclVar
-%type <ast> ListaParametros ListaParametrosCont
-%type <ast> Bloco ListaComando Comando
+%type <ast> Programa DeclFunc DeclProg
+%type <ast> ListaParametros
+%type <ast> Bloco Comando
 %type <ast> Expr OrExpr AndExpr EqExpr DesigExpr
 %type <ast> AddExpr MulExpr UnExpr PrimExpr
-%type <ast> ListExpr Tipo
+%type <ast> Tipo
+
+/* listas: acumuladas com lista_adiciona() e fechadas com lista_finaliza()
+   pela regra que as consome */
+%type <lista> DeclFuncVar ListaDeclVar DeclVar
+%type <lista> ListaComando ListExpr ListaParametrosCont
 
 %%
 
@@ -60,7 +92,8 @@
 Programa
     : DeclFuncVar DeclProg
         {
-            $$ = ast_cria_com_filhos(AST_PROGRAMA,NULL,@1.first_line,2,$1,$2);
+            AST *globais = lista_finaliza($1,AST_LISTA_DECL_VAR);
+            $$ = ast_cria_com_filhos(AST_PROGRAMA,NULL,@1.first_line,2,globais,$2);
             arvore_raiz = $$;
         }
     ;
@@ -71,40 +104,34 @@ Programa
 DeclFuncVar
     /* lista vazia → nó LISTA vazio, nunca NULL */
     : /* ε */
-        { $$ = ast_cria(AST_LISTA_DECL_VAR,NULL,yylineno); }
+        { $$ = lista_nova(yylineno); }
 
     /* var global */
     | DeclFuncVar Tipo ID DeclVar ';'
     {
         /* primeiro id */
-        AST *var0 = ast_cria(AST_DECL_VARIAVEL, $3, @3.first_line);
-        ast_adiciona_filho(var0, $2);   /* usa o nó $2 original */
-
-        AST *lista = $1 ? $1 : ast_cria(AST_LISTA_DECL_VAR, NULL, @3.first_line);
-        ast_adiciona_filho(lista, var0);
+        AST *var0 = ast_cria_com_filhos(AST_DECL_VARIAVEL, $3, @3.first_line, 1, $2);
+        lista_adiciona($1, var0);       /* usa o nó $2 original */
 
         /* demais ids vindos de DeclVar */
-        if ($4)
-            for (int i = 0; i < $4->n_filhos; ++i) {
-                AST *v = $4->filhos[i];
-                /* ---- CÓPIA do nó de tipo ---- */
-                AST *tipo_copia = ast_cria($2->tipo, $2->valor, $2->linha);
-                ast_adiciona_filho(v, tipo_copia);
-                ast_adiciona_filho(lista, v);
-            }
-        $$ = lista;
+        for (int i = 0; i < $4->n; ++i) {
+            AST *v = $4->itens[i];
+            /* ---- CÓPIA do nó de tipo ---- */
+            AST *tipo_copia = ast_cria($2->tipo, $2->valor, $2->linha);
+            ast_adiciona_filho(v, tipo_copia);
+            lista_adiciona($1, v);
+        }
+        lista_descarta($4);
+        $$ = $1;
     }
 
     /* função global */
     | DeclFuncVar Tipo ID DeclFunc
         {
-            AST *func = ast_cria(AST_DECL_FUNCAO,$3,@3.first_line);
-            ast_adiciona_filho(func,$2);      /* tipo retorno */
-            ast_adiciona_filho(func,$4);      /* corpo        */
-
-            AST *lista = $1 ? $1 : ast_cria(AST_LISTA_DECL_VAR,NULL,@1.first_line);
-            ast_adiciona_filho(lista,func);
-            $$ = lista;
+            /* filhos: tipo de retorno, corpo */
+            AST *func = ast_cria_com_filhos(AST_DECL_FUNCAO,$3,@3.first_line,2,$2,$4);
+            lista_adiciona($1,func);
+            $$ = $1;
         }
     ;
 
@@ -119,37 +146,33 @@ DeclFunc
 /* ====================================================== */
 ListaDeclVar
     : /* ε */
-        { $$ = ast_cria(AST_LISTA_DECL_VAR,NULL,yylineno); }
+        { $$ = lista_nova(yylineno); }
 
     | ListaDeclVar Tipo ID DeclVar ';'
     {
-        AST *var0 = ast_cria(AST_DECL_VARIAVEL,$3,@3.first_line);
-        ast_adiciona_filho(var0,$2);
-
-        AST *lista = $1 ? $1 : ast_cria(AST_LISTA_DECL_VAR,NULL,@3.first_line);
-        ast_adiciona_filho(lista,var0);
-
-        if ($4)
-            for (int i=0;i<$4->n_filhos;++i){
-                AST *v = $4->filhos[i];
-                AST *tipo_copia = ast_cria($2->tipo,$2->valor,$2->linha);
-                ast_adiciona_filho(v,tipo_copia);
-                ast_adiciona_filho(lista,v);
-            }
-        $$ = lista;
+        AST *var0 = ast_cria_com_filhos(AST_DECL_VARIAVEL,$3,@3.first_line,1,$2);
+        lista_adiciona($1,var0);
+
+        for (int i=0;i<$4->n;++i){
+            AST *v = $4->itens[i];
+            AST *tipo_copia = ast_cria($2->tipo,$2->valor,$2->linha);
+            ast_adiciona_filho(v,tipo_copia);
+            lista_adiciona($1,v);
+        }
+        lista_descarta($4);
+        $$ = $1;
     }
     ;
 
+/* demais ids de "int a, b, c;" (recursão à esquerda: ordem do fonte) */
 DeclVar
     : /* ε */
-        { $$ = ast_cria(AST_LISTA_DECL_VAR, NULL, yylineno); }
+        { $$ = lista_nova(yylineno); }
 
-    | ',' ID DeclVar
+    | DeclVar ',' ID
         {
-            AST *var = ast_cria(AST_DECL_VARIAVEL, $2, @2.first_line);
-            AST *lista = $3 ? $3 : ast_cria(AST_LISTA_DECL_VAR, NULL, @2.first_line);
-            ast_adiciona_filho(lista, var);
-            $$ = lista;
+            lista_adiciona($1, ast_cria(AST_DECL_VARIAVEL, $3, @3.first_line));
+            $$ = $1;
         }
     ;
 
@@ -157,20 +180,21 @@ DeclVar
 Bloco
     : '{' ListaDeclVar ListaComando '}'
         {
-            $$ = ast_cria_com_filhos(AST_BLOCO,NULL,@1.first_line,2,$2,$3);
+            AST *decls = lista_finaliza($2,AST_LISTA_DECL_VAR);
+            AST *cmds  = lista_finaliza($3,AST_LISTA_COMANDO);
+            $$ = ast_cria_com_filhos(AST_BLOCO,NULL,@1.first_line,2,decls,cmds);
         }
     ;
 
 /* lista de comandos */
 ListaComando
     : /* ε */
-        { $$ = ast_cria(AST_LISTA_COMANDO,NULL,yylineno); }
+        { $$ = lista_nova(yylineno); }
 
     | ListaComando Comando
         {
-            AST *lista = $1 ? $1 : ast_cria(AST_LISTA_COMANDO,NULL,@2.first_line);
-            ast_adiciona_filho(lista,$2);
-            $$ = lista;
+            lista_adiciona($1,$2);
+            $$ = $1;
         }
     ;
 
@@ -178,7 +202,7 @@ ListaComando
 /*   Comandos                                             */
 /* ====================================================== */
 Comando
-    : ';'                    { $$ = ast_cria(AST_COMANDO,";",@1.first_line); }
+    : ';'                    { $$ = ast_cria(AST_COMANDO,intern_str(";"),@1.first_line); }
 
     | Expr ';'               { $$ = $1; }
 
@@ -229,77 +253,87 @@ Expr
     | ID '=' Expr
         {
             AST *id = ast_cria(AST_ID,$1,@1.first_line);
-            $$ = ast_cria_com_filhos(AST_ATRIB,"=",@2.first_line,2,id,$3);
+            $$ = ast_cria_com_filhos(AST_ATRIB,intern_str("="),@2.first_line,2,id,$3);
         }
     ;
 
 OrExpr
     : OrExpr OU AndExpr
-        { $$ = ast_cria_com_filhos(AST_OP,"ou",@2.first_line,2,$1,$3); }
+        { $$ = ast_cria_op(OP_OU,@2.first_line,$1,$3); }
     | AndExpr
         { $$ = $1; }
     ;
 
 AndExpr
     : AndExpr E EqExpr
-        { $$ = ast_cria_com_filhos(AST_OP,"e",@2.first_line,2,$1,$3); }
+        { $$ = ast_cria_op(OP_E,@2.first_line,$1,$3); }
     | EqExpr
         { $$ = $1; }
     ;
 
 EqExpr
-    : EqExpr EQ  DesigExpr   { $$ = ast_cria_com_filhos(AST_OP,"==",@2.first_line,2,$1,$3); }
-    | EqExpr NEQ DesigExpr   { $$ = ast_cria_com_filhos(AST_OP,"!=",@2.first_line,2,$1,$3); }
+    : EqExpr EQ  DesigExpr   { $$ = ast_cria_op(OP_IGUAL,@2.first_line,$1,$3); }
+    | EqExpr NEQ DesigExpr   { $$ = ast_cria_op(OP_DIFERENTE,@2.first_line,$1,$3); }
     | DesigExpr              { $$ = $1; }
     ;
 
 DesigExpr
-    : DesigExpr '<'  AddExpr { $$ = ast_cria_com_filhos(AST_OP,"<",@2.first_line,2,$1,$3); }
-    | DesigExpr '>'  AddExpr { $$ = ast_cria_com_filhos(AST_OP,">",@2.first_line,2,$1,$3); }
-    | DesigExpr LEQ AddExpr  { $$ = ast_cria_com_filhos(AST_OP,"<=",@2.first_line,2,$1,$3); }
-    | DesigExpr GEQ AddExpr  { $$ = ast_cria_com_filhos(AST_OP,">=",@2.first_line,2,$1,$3); }
+    : DesigExpr '<'  AddExpr { $$ = ast_cria_op(OP_MENOR,@2.first_line,$1,$3); }
+    | DesigExpr '>'  AddExpr { $$ = ast_cria_op(OP_MAIOR,@2.first_line,$1,$3); }
+    | DesigExpr LEQ AddExpr  { $$ = ast_cria_op(OP_MENOR_IGUAL,@2.first_line,$1,$3); }
+    | DesigExpr GEQ AddExpr  { $$ = ast_cria_op(OP_MAIOR_IGUAL,@2.first_line,$1,$3); }
     | AddExpr               { $$ = $1; }
     ;
 
 AddExpr
-    : AddExpr '+' MulExpr   { $$ = ast_cria_com_filhos(AST_OP,"+",@2.first_line,2,$1,$3); }
-    | AddExpr '-' MulExpr   { $$ = ast_cria_com_filhos(AST_OP,"-",@2.first_line,2,$1,$3); }
+    : AddExpr '+' MulExpr   { $$ = ast_cria_op(OP_SOMA,@2.first_line,$1,$3); }
+    | AddExpr '-' MulExpr   { $$ = ast_cria_op(OP_SUB,@2.first_line,$1,$3); }
     | MulExpr               { $$ = $1; }
     ;
 
 MulExpr
-    : MulExpr '*' UnExpr    { $$ = ast_cria_com_filhos(AST_OP,"*",@2.first_line,2,$1,$3); }
-    | MulExpr '/' UnExpr    { $$ = ast_cria_com_filhos(AST_OP,"/",@2.first_line,2,$1,$3); }
+    : MulExpr '*' UnExpr    { $$ = ast_cria_op(OP_MUL,@2.first_line,$1,$3); }
+    | MulExpr '/' UnExpr    { $$ = ast_cria_op(OP_DIV,@2.first_line,$1,$3); }
     | UnExpr                { $$ = $1; }
     ;
 
 UnExpr
-    : '-' UnExpr   %prec UMINUS { $$ = ast_cria_com_filhos(AST_OP,"uminus",@1.first_line,1,$2); }
-    | '!' UnExpr                { $$ = ast_cria_com_filhos(AST_OP,"!",@1.first_line,1,$2); }
+    : '-' UnExpr   %prec UMINUS { $$ = ast_cria_op(OP_NEG,@1.first_line,$2,NULL); }
+    | '!' UnExpr                { $$ = ast_cria_op(OP_NAO,@1.first_line,$2,NULL); }
     | PrimExpr                  { $$ = $1; }
     ;
 
 PrimExpr
     : ID '(' ListExpr ')'
         {
-            AST *call = ast_cria(AST_CHAMADA_FUNCAO,$1,@1.first_line);
-            if ($3) ast_adiciona_filho(call,$3);
-            $$ = call;
+            AST *args = lista_finaliza($3,AST_LISTA_EXPR);
+            $$ = ast_cria_com_filhos(AST_CHAMADA_FUNCAO,$1,@1.first_line,1,args);
         }
     | ID '(' ')'                { $$ = ast_cria(AST_CHAMADA_FUNCAO,$1,@1.first_line); }
     | ID                        { $$ = ast_cria(AST_ID,$1,@1.first_line); }
     | CARCONST                  { $$ = ast_cria(AST_CAR,$1,@1.first_line); }
-    | INTCONST                  { $$ = ast_cria(AST_INT,$1,@1.first_line); }
+    | INTCONST
+        {
+            if (!inteiro_cabe($1)) {
+                fprintf(stderr, "ERRO: constante inteira fora do intervalo linha %d\n",
+                        @1.first_line);
+                YYABORT;
+            }
+            $$ = ast_cria(AST_INT,$1,@1.first_line);
+        }
     | '(' Expr ')'              { $$ = $2; }
     ;
 
 ListExpr
     : Expr
-        { $$ = ast_cria_com_filhos(AST_LISTA_EXPR,NULL,@1.first_line,1,$1); }
+        {
+            $$ = lista_nova(@1.first_line);
+            lista_adiciona($$,$1);
+        }
     | ListExpr ',' Expr
         {
+            lista_adiciona($1,$3);
             $$ = $1;
-            ast_adiciona_filho($$,$3);
         }
     ;
 
@@ -307,8 +341,8 @@ ListExpr
 /*   Tipos                                                */
 /* ====================================================== */
 Tipo
-    : INT   { $$ = ast_cria(AST_INT,"int",@1.first_line); }
-    | CAR   { $$ = ast_cria(AST_CAR,"car",@1.first_line); }
+    : INT   { $$ = ast_cria(AST_INT,intern_str("int"),@1.first_line); }
+    | CAR   { $$ = ast_cria(AST_CAR,intern_str("car"),@1.first_line); }
     ;
 
 /* ====================================================== */
@@ -318,7 +352,7 @@ ListaParametros
     : /* ε */
         { $$ = ast_cria(AST_LISTA_PARAM,NULL,yylineno); }
     | ListaParametrosCont
-        { $$ = $1; }
+        { $$ = lista_finaliza($1,AST_LISTA_PARAM); }
     ;
 
 ListaParametrosCont
@@ -326,14 +360,15 @@ ListaParametrosCont
         {
             AST *id = ast_cria(AST_ID,$2,@2.first_line);
             AST *par = ast_cria_com_filhos(AST_PARAM,NULL,@1.first_line,2,$1,id);
-            $$ = ast_cria_com_filhos(AST_LISTA_PARAM,NULL,@1.first_line,1,par);
+            $$ = lista_nova(@1.first_line);
+            lista_adiciona($$,par);
         }
     | ListaParametrosCont ',' Tipo ID
         {
             AST *id = ast_cria(AST_ID,$4,@4.first_line);
             AST *par = ast_cria_com_filhos(AST_PARAM,NULL,@3.first_line,2,$3,id);
+            lista_adiciona($1,par);
             $$ = $1;
-            ast_adiciona_filho($$,par);
         }
     ;
 
@@ -342,7 +377,7 @@ ListaParametrosCont
 /* ====================================================== */
 DeclProg
     : PROGRAMA Bloco
-        { $$ = ast_cria_com_filhos(AST_DECL_FUNCAO,"programa",@1.first_line,1,$2); }
+        { $$ = ast_cria_com_filhos(AST_DECL_FUNCAO,intern_str("programa"),@1.first_line,1,$2); }
     ;
 
 %%
@@ -0,0 +1,124 @@
+#include "intern.h"
+#include "arena.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Cada grafia é guardada na arena logo após este cabeçalho; o ponteiro
+ * entregue aos clientes é 'texto', e o cabeçalho é achado voltando
+ * offsetof(Internado, texto) bytes. */
+typedef struct Internado {
+    uint32_t id;
+    uint32_t hash;
+    uint32_t tamanho;
+    char     texto[];
+} Internado;
+
+static Arena       arena_intern;
+static Internado **tabela = NULL;      /* endereçamento aberto          */
+static size_t      capacidade = 0;     /* sempre potência de 2          */
+static Internado **por_id = NULL;      /* id -> entrada                 */
+static int         total = 0, cap_ids = 0;
+
+static uint32_t fnv1a(const char *s, size_t n) {
+    uint32_t h = 2166136261u;
+    for (size_t i = 0; i < n; ++i) {
+        h ^= (unsigned char)s[i];
+        h *= 16777619u;
+    }
+    return h;
+}
+
+static void *aloca_zerado(size_t n, size_t tam) {
+    void *p = calloc(n, tam);
+    if (!p) {
+        fprintf(stderr, "ERRO: memória insuficiente na tabela de nomes.\n");
+        exit(1);
+    }
+    return p;
+}
+
+static void rehash(size_t nova) {
+    Internado **nova_tab = aloca_zerado(nova, sizeof *nova_tab);
+    for (size_t i = 0; i < capacidade; ++i) {
+        Internado *e = tabela[i];
+        if (!e) continue;
+        size_t j = e->hash & (nova - 1);
+        while (nova_tab[j]) j = (j + 1) & (nova - 1);
+        nova_tab[j] = e;
+    }
+    free(tabela);
+    tabela = nova_tab;
+    capacidade = nova;
+}
+
+const char *intern(const char *s, size_t n) {
+    if (!tabela) {
+        arena_inicia(&arena_intern, 0);
+        rehash(1024);
+    }
+    uint32_t h = fnv1a(s, n);
+    size_t j = h & (capacidade - 1);
+    for (Internado *e; (e = tabela[j]) != NULL; j = (j + 1) & (capacidade - 1))
+        if (e->hash == h && e->tamanho == n && memcmp(e->texto, s, n) == 0)
+            return e->texto;
+
+    Internado *e = arena_aloca(&arena_intern, sizeof(Internado) + n + 1);
+    e->id = total;
+    e->hash = h;
+    e->tamanho = n;
+    memcpy(e->texto, s, n);
+    e->texto[n] = '\0';
+    tabela[j] = e;
+
+    if (total == cap_ids) {
+        cap_ids = cap_ids ? 2 * cap_ids : 1024;
+        por_id = realloc(por_id, cap_ids * sizeof *por_id);
+        if (!por_id) {
+            fprintf(stderr, "ERRO: memória insuficiente na tabela de nomes.\n");
+            exit(1);
+        }
+    }
+    por_id[total++] = e;
+
+    /* mantém a carga abaixo de 1/2 */
+    if ((size_t)total * 2 > capacidade)
+        rehash(capacidade * 2);
+    return e->texto;
+}
+
+const char *intern_str(const char *s) {
+    return intern(s, strlen(s));
+}
+
+static const Internado *cabecalho(const char *p) {
+    return (const Internado *)(p - offsetof(Internado, texto));
+}
+
+int intern_id(const char *p) {
+    return (int)cabecalho(p)->id;
+}
+
+const char *intern_nome(int id) {
+    return (id >= 0 && id < total) ? por_id[id]->texto : NULL;
+}
+
+size_t intern_tamanho(const char *p) {
+    return cabecalho(p)->tamanho;
+}
+
+int intern_total(void) {
+    return total;
+}
+
+void intern_libera(void) {
+    if (!tabela) return;
+    free(tabela);
+    free(por_id);
+    tabela = NULL;
+    por_id = NULL;
+    capacidade = 0;
+    total = cap_ids = 0;
+    arena_destroi(&arena_intern);
+}
@@ -0,0 +1,26 @@
+/* ------------------------------------------------------------------
+ * intern.h  –  Tabela global de internação de identificadores e
+ *              literais (cada grafia distinta é guardada uma única vez)
+ * ------------------------------------------------------------------ */
+#ifndef INTERN_H
+#define INTERN_H
+
+#include <stddef.h>
+
+/* Devolve o ponteiro canônico da grafia s[0..n-1]. Duas chamadas com a
+ * mesma grafia devolvem o MESMO ponteiro, então as fases seguintes
+ * comparam nomes com '==' em vez de strcmp. O texto é terminado em '\0'
+ * e vive até intern_libera(). */
+const char *intern(const char *s, size_t n);
+const char *intern_str(const char *s);
+
+/* Identificador inteiro (0, 1, 2, ...) de um ponteiro devolvido por
+ * intern(), e o caminho inverso. */
+int         intern_id(const char *p);
+const char *intern_nome(int id);
+size_t      intern_tamanho(const char *p);   /* strlen sem percorrer */
+int         intern_total(void);
+
+void intern_libera(void);
+
+#endif /* INTERN_H */
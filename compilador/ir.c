@@ -0,0 +1,321 @@
+/* =====================================================================
+ * ir.c  ─  Instruções de três endereços de cada função, blocos
+ *          básicos (CFG) e vivacidade dos registradores
+ * ===================================================================== */
+#include "ir.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+const char *const IR_NOME_REG[32] = {
+    "$zero","$at","$v0","$v1","$a0","$a1","$a2","$a3",
+    "$t0","$t1","$t2","$t3","$t4","$t5","$t6","$t7",
+    "$s0","$s1","$s2","$s3","$s4","$s5","$s6","$s7",
+    "$t8","$t9","$k0","$k1","$gp","$sp","$fp","$ra"
+};
+
+static const struct { const char *nome; uint8_t classe; } INFO[N_MNEMONICOS] = {
+    [M_NENHUM] = { "",    CL_REMOVIDA },
+    [M_ADD]  = { "add",  CL_NORMAL }, [M_ADDI] = { "addi", CL_NORMAL },
+    [M_SUB]  = { "sub",  CL_NORMAL }, [M_MUL]  = { "mul",  CL_NORMAL },
+    [M_ADDU] = { "addu", CL_NORMAL }, [M_SUBU] = { "subu", CL_NORMAL },
+    [M_MULT] = { "mult", CL_SEM_DESTINO }, [M_DIV] = { "div", CL_NORMAL },
+    [M_MFLO] = { "mflo", CL_NORMAL }, [M_MFHI] = { "mfhi", CL_NORMAL },
+    [M_SLL]  = { "sll",  CL_NORMAL }, [M_SRA]  = { "sra",  CL_NORMAL },
+    [M_SRL]  = { "srl",  CL_NORMAL },
+    [M_SLT]  = { "slt",  CL_NORMAL }, [M_SLTI] = { "slti", CL_NORMAL },
+    [M_SGT]  = { "sgt",  CL_NORMAL }, [M_SLE]  = { "sle",  CL_NORMAL },
+    [M_SGE]  = { "sge",  CL_NORMAL }, [M_SEQ]  = { "seq",  CL_NORMAL },
+    [M_SNE]  = { "sne",  CL_NORMAL },
+    [M_LI]   = { "li",   CL_NORMAL }, [M_LA]   = { "la",   CL_NORMAL },
+    [M_LW]   = { "lw",   CL_NORMAL }, [M_SW]   = { "sw",   CL_SEM_DESTINO },
+    [M_MOVE] = { "move", CL_NORMAL },
+    [M_BEQ]  = { "beq",  CL_DESVIO }, [M_BNE]  = { "bne",  CL_DESVIO },
+    [M_BLT]  = { "blt",  CL_DESVIO }, [M_BGT]  = { "bgt",  CL_DESVIO },
+    [M_BLE]  = { "ble",  CL_DESVIO }, [M_BGE]  = { "bge",  CL_DESVIO },
+    [M_BLTZ] = { "bltz", CL_DESVIO }, [M_BGEZ] = { "bgez", CL_DESVIO },
+    [M_BGTZ] = { "bgtz", CL_DESVIO }, [M_BLEZ] = { "blez", CL_DESVIO },
+    [M_J]    = { "j",    CL_SALTO },  [M_JAL]  = { "jal",  CL_CHAMADA },
+    [M_JR]   = { "jr",   CL_RETORNO },
+    [M_SYSCALL] = { "syscall", CL_SYSCALL },
+    [M_ROTULO]  = { "",  CL_ROTULO },
+    [M_COMENTARIO] = { "", CL_COMENTARIO },
+};
+
+#define R_V0 2
+#define R_SP 29
+#define R_FP 30
+#define R_RA 31
+#define ARGUMENTOS    0x000000f0u   /* $a0..$a3 */
+#define PRESERVADOS   0x00ff0000u   /* $s0..$s7 */
+// o que uma função chamada pode destruir: $at, $v, $a, $t e $ra
+#define DESTRUIDOS    ((0x0300ffffu & ~1u) | IR_BIT(R_RA))
+// vivos na volta ao chamador
+#define DEVOLVIDOS    (IR_BIT(R_V0) | PRESERVADOS | IR_BIT(28) \
+                       | IR_BIT(R_SP) | IR_BIT(R_FP) | IR_BIT(R_RA))
+
+static void sem_memoria(void) {
+    fprintf(stderr, "ERRO: memória insuficiente na representação intermediária.\n");
+    exit(1);
+}
+
+static void *cresce(void *p, size_t *cap, size_t minimo, size_t tam) {
+    if (*cap >= minimo) return p;
+    size_t novo = *cap ? *cap : 1024;
+    while (novo < minimo) novo *= 2;
+    p = realloc(p, novo * tam);
+    if (!p) sem_memoria();
+    *cap = novo;
+    return p;
+}
+
+/* ------------------------------------------------------------------ */
+/* Construção                                                         */
+/* ------------------------------------------------------------------ */
+void ir_inicia(FuncaoIR *f) {
+    memset(f, 0, sizeof *f);
+    bs_abre_memoria(&f->textos);
+}
+
+void ir_limpa(FuncaoIR *f, const char *nome, int eh_programa) {
+    f->nome = nome;
+    f->eh_programa = eh_programa;
+    f->n = 0;
+    f->textos.tam = 0;
+    f->rotulo_min = f->rotulo_max = 0;
+    f->tem_cfg = f->tem_vivos = 0;
+}
+
+void ir_libera(FuncaoIR *f) {
+    free(f->ins);
+    free(f->blocos);
+    free(f->bloco_do_rotulo);
+    free(f->vivos);
+    free(f->trabalho);
+    bs_libera(&f->textos);
+    memset(f, 0, sizeof *f);
+}
+
+size_t ir_instr(FuncaoIR *f, Mnemonico op, int n, Operando a, Operando b, Operando c) {
+    f->ins = cresce(f->ins, &f->cap, f->n + 1, sizeof *f->ins);
+    Instr *i = &f->ins[f->n];
+    i->op = (uint8_t)op;
+    i->n = (uint8_t)n;
+    i->a[0] = a;
+    i->a[1] = b;
+    i->a[2] = c;
+    f->tem_cfg = f->tem_vivos = 0;
+    return f->n++;
+}
+
+BufferSaida *ir_comentario(FuncaoIR *f) {
+    if (f->textos.tam) bs_char(&f->textos, '\0');
+    Operando t = { O_TEXTO, -1, (int32_t)f->textos.tam, NULL };
+    ir_instr(f, M_COMENTARIO, 1, t, ir_nada(), ir_nada());
+    return &f->textos;
+}
+
+Operando ir_nada(void)          { return (Operando){ O_NADA, -1, 0, NULL }; }
+Operando ir_reg(int r)          { return (Operando){ O_REG, (int8_t)r, 0, NULL }; }
+Operando ir_imed(long v)        { return (Operando){ O_IMED, -1, (int32_t)v, NULL }; }
+Operando ir_rotulo(int id)      { return (Operando){ O_ROTULO, -1, id, NULL }; }
+Operando ir_mem(int desl, int base) { return (Operando){ O_MEM, (int8_t)base, desl, NULL }; }
+Operando ir_var(const char *nome)   { return (Operando){ O_VAR, -1, 0, nome }; }
+Operando ir_func(const char *nome)  { return (Operando){ O_FUNC, -1, 0, nome }; }
+Operando ir_str(int id)         { return (Operando){ O_STR, -1, id, NULL }; }
+Operando ir_simbolo(const char *nome) { return (Operando){ O_SIMBOLO, -1, 0, nome }; }
+
+/* ------------------------------------------------------------------ */
+/* Efeito de cada instrução                                           */
+/* ------------------------------------------------------------------ */
+const char *ir_nome(Mnemonico op) {
+    return INFO[op].nome;
+}
+
+ClasseInstr ir_classe(const Instr *i) {
+    if (i->op == M_DIV && i->n == 2) return CL_SEM_DESTINO;  // div rs, rt
+    return (ClasseInstr)INFO[i->op].classe;
+}
+
+uint32_t ir_le(const Instr *i) {
+    ClasseInstr c = ir_classe(i);
+    uint32_t m = 0;
+    switch (c) {
+        case CL_CHAMADA: return ARGUMENTOS | IR_BIT(R_SP);
+        case CL_RETORNO: return DEVOLVIDOS;
+        case CL_SYSCALL: return IR_BIT(R_V0) | IR_BIT(4);
+        case CL_ROTULO: case CL_COMENTARIO: case CL_REMOVIDA: return 0;
+        default: break;
+    }
+    for (int k = 0; k < i->n; ++k) {
+        const Operando *o = &i->a[k];
+        if (o->tipo == O_MEM) m |= IR_BIT(o->reg);
+        else if (o->tipo == O_REG && (k > 0 || c != CL_NORMAL)) m |= IR_BIT(o->reg);
+    }
+    return m & ~1u;                 // $zero não conta
+}
+
+uint32_t ir_escreve(const Instr *i) {
+    switch (ir_classe(i)) {
+        case CL_NORMAL:
+            return i->a[0].tipo == O_REG ? IR_BIT(i->a[0].reg) & ~1u : 0;
+        case CL_CHAMADA: return DESTRUIDOS;
+        case CL_SYSCALL: return IR_BIT(R_V0);
+        default: return 0;
+    }
+}
+
+int ir_alvo(const Instr *i) {
+    return i->n > 0 && i->a[i->n - 1].tipo == O_ROTULO ? i->a[i->n - 1].valor : -1;
+}
+
+uint32_t *ir_trabalho(FuncaoIR *f, size_t n) {
+    f->trabalho = cresce(f->trabalho, &f->cap_trabalho, n, sizeof *f->trabalho);
+    return f->trabalho;
+}
+
+/* ------------------------------------------------------------------ */
+/* Blocos básicos                                                     */
+/* ------------------------------------------------------------------ */
+// Um bloco começa na primeira instrução, num rótulo ou depois de um
+// desvio, salto ou retorno. jal não termina bloco: a função chamada
+// volta para a instrução seguinte.
+static int termina_bloco(const Instr *i) {
+    ClasseInstr c = ir_classe(i);
+    return c == CL_DESVIO || c == CL_SALTO || c == CL_RETORNO;
+}
+
+// Bloco que começa no rótulo 'id', ou -1 (fora da função)
+static int32_t bloco_do(const FuncaoIR *f, int id) {
+    if (id < f->rotulo_min || id >= f->rotulo_max) return -1;
+    return f->bloco_do_rotulo[id - f->rotulo_min];
+}
+
+void ir_cfg(FuncaoIR *f) {
+    size_t n_rot = (size_t)(f->rotulo_max - f->rotulo_min);
+    f->bloco_do_rotulo = cresce(f->bloco_do_rotulo, &f->cap_rotulos, n_rot + 1,
+                                sizeof *f->bloco_do_rotulo);
+    for (size_t k = 0; k < n_rot; ++k) f->bloco_do_rotulo[k] = -1;
+
+    f->n_blocos = 0;
+    for (size_t i = 0; i < f->n; ) {
+        f->blocos = cresce(f->blocos, &f->cap_blocos, f->n_blocos + 1,
+                           sizeof *f->blocos);
+        Bloco *b = &f->blocos[f->n_blocos];
+        b->ini = (uint32_t)i;
+        // rótulos (e comentários) do começo pertencem a este bloco
+        for (; i < f->n && (f->ins[i].op == M_ROTULO || f->ins[i].op == M_COMENTARIO
+                            || f->ins[i].op == M_NENHUM); ++i)
+            if (f->ins[i].op == M_ROTULO) {
+                int id = f->ins[i].a[0].valor;
+                if (id >= f->rotulo_min && id < f->rotulo_max)
+                    f->bloco_do_rotulo[id - f->rotulo_min] = (int32_t)f->n_blocos;
+            }
+        for (; i < f->n && f->ins[i].op != M_ROTULO; ++i)
+            if (termina_bloco(&f->ins[i])) { ++i; break; }
+        b->fim = (uint32_t)i;
+        ++f->n_blocos;
+    }
+
+    for (size_t k = 0; k < f->n_blocos; ++k) {
+        Bloco *b = &f->blocos[k];
+        int32_t seguinte = k + 1 < f->n_blocos ? (int32_t)k + 1 : -1;
+        b->suc[0] = b->suc[1] = -1;
+        const Instr *ult = NULL;
+        for (uint32_t i = b->fim; i > b->ini; --i) {
+            ClasseInstr c = ir_classe(&f->ins[i - 1]);
+            if (c != CL_COMENTARIO && c != CL_REMOVIDA) { ult = &f->ins[i - 1]; break; }
+        }
+        ClasseInstr c = ult ? ir_classe(ult) : CL_NORMAL;
+        if (c == CL_SALTO) {
+            b->suc[0] = bloco_do(f, ir_alvo(ult));
+        } else if (c == CL_DESVIO) {
+            b->suc[0] = seguinte;
+            b->suc[1] = bloco_do(f, ir_alvo(ult));
+        } else if (c != CL_RETORNO) {
+            b->suc[0] = seguinte;
+        }
+    }
+    f->tem_cfg = 1;
+    f->tem_vivos = 0;
+}
+
+/* ------------------------------------------------------------------ */
+/* Vivacidade                                                         */
+/* ------------------------------------------------------------------ */
+// Fluxo de dados para trás sobre as máscaras de 32 registradores.
+// Cada máscara só cresce, então cada bloco volta à lista no máximo 32
+// vezes por sucessor: o custo é linear no tamanho da função.
+void ir_vivacidade(FuncaoIR *f) {
+    if (!f->tem_cfg) ir_cfg(f);
+    size_t nb = f->n_blocos;
+
+    // predecessores em vetor único (deslocamentos e lista), a lista de
+    // trabalho e a marca de quem está nela, todos na área de trabalho
+    uint32_t *inicio_pred = ir_trabalho(f, 5 * nb + 2), *pred = inicio_pred + nb + 1;
+    uint32_t *lista = pred + 2 * nb, *na_lista = lista + nb;
+    memset(inicio_pred, 0, (nb + 1) * sizeof *inicio_pred);
+    for (size_t k = 0; k < nb; ++k)
+        for (int s = 0; s < 2; ++s)
+            if (f->blocos[k].suc[s] >= 0) ++inicio_pred[f->blocos[k].suc[s] + 1];
+    for (size_t k = 0; k < nb; ++k) inicio_pred[k + 1] += inicio_pred[k];
+    for (size_t k = 0; k < nb; ++k) lista[k] = inicio_pred[k];
+    for (size_t k = 0; k < nb; ++k)
+        for (int s = 0; s < 2; ++s)
+            if (f->blocos[k].suc[s] >= 0) pred[lista[f->blocos[k].suc[s]]++] = (uint32_t)k;
+
+    // uso e def de cada bloco; desvio para fora da função: tudo vivo
+    for (size_t k = 0; k < nb; ++k) {
+        Bloco *b = &f->blocos[k];
+        b->uso = b->def = 0;
+        for (uint32_t i = b->fim; i-- > b->ini; ) {
+            uint32_t le = ir_le(&f->ins[i]), esc = ir_escreve(&f->ins[i]);
+            b->uso = (b->uso & ~esc) | le;
+            b->def |= esc;
+        }
+        b->sai = 0;
+        const Instr *ult = b->fim > b->ini ? &f->ins[b->fim - 1] : NULL;
+        if (ult && (ir_classe(ult) == CL_SALTO || ir_classe(ult) == CL_DESVIO)
+            && bloco_do(f, ir_alvo(ult)) < 0)
+            b->sai = ~0u;
+        b->entra = b->uso | (b->sai & ~b->def);
+    }
+
+    // lista de trabalho, de trás para a frente
+    size_t n_lista = 0;
+    for (size_t k = 0; k < nb; ++k) { lista[n_lista++] = (uint32_t)k; na_lista[k] = 1; }
+    while (n_lista) {
+        uint32_t k = lista[--n_lista];
+        na_lista[k] = 0;
+        Bloco *b = &f->blocos[k];
+        uint32_t sai = b->sai;
+        for (int s = 0; s < 2; ++s)
+            if (b->suc[s] >= 0) sai |= f->blocos[b->suc[s]].entra;
+        uint32_t entra = b->uso | (sai & ~b->def);
+        b->sai = sai;
+        if (entra == b->entra) continue;
+        b->entra = entra;
+        for (uint32_t p = inicio_pred[k]; p < inicio_pred[k + 1]; ++p)
+            if (!na_lista[pred[p]]) { na_lista[pred[p]] = 1; lista[n_lista++] = pred[p]; }
+    }
+
+    // vivos depois de cada instrução
+    f->vivos = cresce(f->vivos, &f->cap_vivos, f->n + 1, sizeof *f->vivos);
+    for (size_t k = 0; k < nb; ++k) {
+        Bloco *b = &f->blocos[k];
+        uint32_t vivo = b->sai;
+        for (uint32_t i = b->fim; i-- > b->ini; ) {
+            f->vivos[i] = vivo;
+            vivo = (vivo & ~ir_escreve(&f->ins[i])) | ir_le(&f->ins[i]);
+        }
+    }
+    f->tem_vivos = 1;
+}
+
+void ir_compacta(FuncaoIR *f) {
+    size_t j = 0;
+    for (size_t i = 0; i < f->n; ++i)
+        if (f->ins[i].op != M_NENHUM) f->ins[j++] = f->ins[i];
+    f->n = j;
+    f->tem_cfg = f->tem_vivos = 0;
+}
@@ -0,0 +1,143 @@
+/* ------------------------------------------------------------------
+ * ir.h  –  Representação intermediária do código de uma função:
+ *          instruções de três endereços no nível da máquina (os
+ *          operandos já são registradores MIPS, imediatos, rótulos e
+ *          endereços), com blocos básicos e vivacidade calculados sob
+ *          demanda pelos passes
+ * ------------------------------------------------------------------ */
+#ifndef IR_H
+#define IR_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "buffer_saida.h"
+
+typedef enum {
+    M_NENHUM,           /* instrução apagada por um passe */
+    M_ADD, M_ADDI, M_SUB, M_ADDU, M_SUBU, M_MUL, M_MULT, M_DIV, M_MFLO, M_MFHI,
+    M_SLL, M_SRA, M_SRL,
+    M_SLT, M_SLTI, M_SGT, M_SLE, M_SGE, M_SEQ, M_SNE,
+    M_LI, M_LA, M_LW, M_SW, M_MOVE,
+    M_BEQ, M_BNE, M_BLT, M_BGT, M_BLE, M_BGE,
+    M_BLTZ, M_BGEZ, M_BGTZ, M_BLEZ,
+    M_J, M_JAL, M_JR, M_SYSCALL,
+    M_ROTULO,           /* pseudo: "L<n>:" */
+    M_COMENTARIO,       /* pseudo: "# ..." */
+    N_MNEMONICOS
+} Mnemonico;
+
+/* O que a instrução faz com os operandos e com o fluxo */
+typedef enum {
+    CL_NORMAL,           /* escreve no 1º operando e lê os outros      */
+    CL_SEM_DESTINO,      /* sw, mult, div de dois operandos: só lê     */
+    CL_DESVIO,           /* condicional; o último operando é o rótulo  */
+    CL_SALTO,            /* j                                          */
+    CL_CHAMADA,          /* jal                                        */
+    CL_RETORNO,          /* jr                                         */
+    CL_SYSCALL,
+    CL_ROTULO,
+    CL_COMENTARIO,
+    CL_REMOVIDA,
+} ClasseInstr;
+
+typedef enum {
+    O_NADA,
+    O_REG,              /* reg                                        */
+    O_IMED,             /* valor                                      */
+    O_ROTULO,           /* L<valor>                                   */
+    O_MEM,              /* valor(reg)                                 */
+    O_VAR,              /* var_<nome> (global)                        */
+    O_FUNC,             /* user_<nome>, ou main para "programa"       */
+    O_STR,              /* str<valor>                                 */
+    O_SIMBOLO,          /* nome tal como está (ex.: "nl")             */
+    O_TEXTO,            /* comentário em textos[valor..], até o '\0'  */
+} TipoOperando;
+
+typedef struct {
+    uint8_t     tipo;
+    int8_t      reg;
+    int32_t     valor;
+    const char *nome;   /* O_VAR e O_FUNC (nomes internados), O_SIMBOLO */
+} Operando;
+
+typedef struct {
+    uint8_t  op;        /* Mnemonico */
+    uint8_t  n;         /* operandos usados */
+    Operando a[3];
+} Instr;
+
+/* Bloco básico: instruções [ini, fim); suc[k] < 0 é "sem sucessor" */
+typedef struct {
+    uint32_t ini, fim;
+    int32_t  suc[2];
+    uint32_t uso, def;      /* lidos antes de escritos / escritos     */
+    uint32_t entra, sai;    /* vivos na entrada e na saída            */
+} Bloco;
+
+typedef struct FuncaoIR {
+    const char *nome;       /* internado */
+    int         eh_programa;
+    Instr      *ins;
+    size_t      n, cap;
+    BufferSaida textos;     /* texto dos comentários */
+    int rotulo_min, rotulo_max;     /* rótulos L<n> da função: [min, max) */
+
+    /* análises; um passe que muda alguma coisa as invalida */
+    int       tem_cfg, tem_vivos;
+    Bloco    *blocos;
+    size_t    n_blocos, cap_blocos;
+    int32_t  *bloco_do_rotulo;      /* rotulo - rotulo_min -> bloco */
+    size_t    cap_rotulos;
+    uint32_t *vivos;                /* por instrução: vivos depois dela */
+    size_t    cap_vivos;
+    uint32_t *trabalho;             /* área das análises */
+    size_t    cap_trabalho;
+} FuncaoIR;
+
+#define IR_BIT(r)  (1u << (r))
+
+extern const char *const IR_NOME_REG[32];
+
+void ir_inicia(FuncaoIR *f);
+/* Esvazia f para a próxima função, reaproveitando a memória */
+void ir_limpa(FuncaoIR *f, const char *nome, int eh_programa);
+void ir_libera(FuncaoIR *f);
+
+/* Acrescenta uma instrução (operandos além de n são ignorados) e
+ * devolve o índice dela */
+size_t ir_instr(FuncaoIR *f, Mnemonico op, int n, Operando a, Operando b, Operando c);
+/* Acrescenta um comentário; o texto é escrito pelo chamador no buffer
+ * devolvido, até o próximo ir_comentario ou a emissão */
+BufferSaida *ir_comentario(FuncaoIR *f);
+
+Operando ir_nada(void);
+Operando ir_reg(int r);
+Operando ir_imed(long v);
+Operando ir_rotulo(int id);
+Operando ir_mem(int desl, int base);
+Operando ir_var(const char *nome);
+Operando ir_func(const char *nome);
+Operando ir_str(int id);
+Operando ir_simbolo(const char *nome);
+
+const char *ir_nome(Mnemonico op);
+ClasseInstr ir_classe(const Instr *i);
+/* Registradores lidos / escritos pela instrução. jal lê $a0..$a3 e
+ * destrói os que a convenção não preserva; jr lê o que volta para
+ * quem chamou ($v0, $s, $sp, $fp, $ra). */
+uint32_t ir_le(const Instr *i);
+uint32_t ir_escreve(const Instr *i);
+/* Rótulo de destino de um desvio ou salto */
+int ir_alvo(const Instr *i);
+
+/* Área de trabalho das análises e passes, com pelo menos n palavras
+ * (o conteúdo anterior não é preservado entre usos) */
+uint32_t *ir_trabalho(FuncaoIR *f, size_t n);
+
+/* Análises: blocos básicos e sucessores; vivacidade (exige o CFG) */
+void ir_cfg(FuncaoIR *f);
+void ir_vivacidade(FuncaoIR *f);
+/* Tira as instruções apagadas (M_NENHUM) e invalida as análises */
+void ir_compacta(FuncaoIR *f);
+
+#endif /* IR_H */
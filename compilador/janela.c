@@ -0,0 +1,159 @@
+/* =====================================================================
+ * janela.c  ─  Otimização de janela (peephole) nas instruções de cada
+ *              função, sobre a IR
+ * ===================================================================== */
+#include "janela.h"
+#include "estatisticas.h"
+
+// A vivacidade é calculada uma vez, antes das regras, e continua
+// servindo depois delas: destino_direto só muda quem está vivo entre
+// as duas instruções que junta, trecho que a varredura já passou, e as
+// outras regras não aumentam o que está vivo em lugar nenhum.
+static FuncaoIR *fn;
+
+#define INS(i)  (&fn->ins[i])
+
+static int eh_reg(const Operando *o) {
+    return o->tipo == O_REG;
+}
+
+// Mesma posição de memória: desl($r) ou var_<nome>
+static int mesmo_endereco(const Operando *a, const Operando *b) {
+    if (a->tipo != b->tipo) return 0;
+    if (a->tipo == O_MEM) return a->reg == b->reg && a->valor == b->valor;
+    return a->tipo == O_VAR && a->nome == b->nome;
+}
+
+/* ------------------------------------------------------------------ */
+/* Regras                                                             */
+/* ------------------------------------------------------------------ */
+// Cada regra olha a instrução i (e as vizinhas) e devolve 1 se mudou
+// alguma coisa. Para acrescentar uma regra basta escrever a função e
+// pôr uma linha na tabela REGRAS.
+#define JANELA 4                    // instruções para trás em destino_direto
+
+// Instrução anterior a i no mesmo bloco (sem rótulo no meio), ou fn->n
+static size_t anterior(size_t i) {
+    while (i-- > 0) {
+        Mnemonico op = (Mnemonico)INS(i)->op;
+        if (op == M_NENHUM || op == M_COMENTARIO) continue;
+        return op == M_ROTULO ? fn->n : i;
+    }
+    return fn->n;
+}
+
+static void remove_instr(size_t i) { INS(i)->op = M_NENHUM; }
+
+// 'op $t, ...' seguido (em até JANELA instruções) de 'move $x, $t' com
+// $t morto depois: a instrução escreve direto em $x e o move sai.
+// Pega 'la $t0, str0 / move $a0, $t0', 'add $t0, ... / move $v0, $t0'
+// antes do salto para o epílogo, 'move $t0, $v0 / move $s0, $t0', ...
+static int destino_direto(size_t i) {
+    Instr *mv = INS(i);
+    if (mv->op != M_MOVE || !eh_reg(&mv->a[1])) return 0;
+    int x = mv->a[0].reg, t = mv->a[1].reg;
+    if (x <= 0 || t <= 0 || x == t || (fn->vivos[i] & IR_BIT(t))) return 0;
+    uint32_t tocados = IR_BIT(t) | IR_BIT(x);
+    size_t d = i;
+    for (int n = 0; n < JANELA; ++n) {
+        d = anterior(d);
+        if (d == fn->n) return 0;
+        Instr *in = INS(d);
+        ClasseInstr c = ir_classe(in);
+        if (c != CL_NORMAL && c != CL_SEM_DESTINO) return 0;
+        if (ir_escreve(in) & IR_BIT(t)) {
+            if (c != CL_NORMAL) return 0;
+            in->a[0].reg = (int8_t)x;
+            remove_instr(i);
+            return 1;
+        }
+        if ((ir_le(in) | ir_escreve(in)) & tocados) return 0;
+    }
+    return 0;
+}
+
+// 'sw $r, M' seguido de 'lw $q, M': o valor já está em $r
+static int carga_repetida(size_t i) {
+    Instr *lw = INS(i);
+    if (lw->op != M_LW) return 0;
+    size_t a = anterior(i);
+    if (a == fn->n) return 0;
+    Instr *sw = INS(a);
+    if (sw->op != M_SW || !mesmo_endereco(&sw->a[1], &lw->a[1])) return 0;
+    if (lw->a[0].reg == sw->a[0].reg) {
+        remove_instr(i);
+    } else {
+        lw->op = M_MOVE;
+        lw->a[1] = sw->a[0];
+    }
+    return 1;
+}
+
+// 'move $r, $r'
+static int move_inutil(size_t i) {
+    Instr *in = INS(i);
+    if (in->op != M_MOVE || !eh_reg(&in->a[1]) || in->a[0].reg != in->a[1].reg)
+        return 0;
+    remove_instr(i);
+    return 1;
+}
+
+// 'j L' (ou um desvio para L) logo antes de 'L:'
+static int salto_proximo(size_t i) {
+    ClasseInstr c = ir_classe(INS(i));
+    if (c != CL_SALTO && c != CL_DESVIO) return 0;
+    int rotulo = ir_alvo(INS(i));
+    for (size_t k = i + 1; k < fn->n; ++k) {
+        Instr *r = INS(k);
+        if (r->op == M_NENHUM || r->op == M_COMENTARIO) continue;
+        if (r->op != M_ROTULO) return 0;
+        if (r->a[0].valor == rotulo) {
+            remove_instr(i);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static const struct {
+    const char *contador;
+    int (*aplica)(size_t i);
+} REGRAS[] = {
+    { "janela.move_inutil",    move_inutil },
+    { "janela.carga_repetida", carga_repetida },
+    { "janela.destino_direto", destino_direto },
+    { "janela.salto_proximo",  salto_proximo },
+};
+#define N_REGRAS ((int)(sizeof REGRAS / sizeof REGRAS[0]))
+
+/* ------------------------------------------------------------------ */
+/* Passe                                                              */
+/* ------------------------------------------------------------------ */
+long otimiza_janela(FuncaoIR *f) {
+    long acertos[N_REGRAS] = {0};
+    long total = 0;
+    fn = f;
+
+    // Regras na ordem da tabela; depois de uma mudança a mesma
+    // instrução é tentada de novo (um lw que virou move pode sumir em
+    // seguida)
+    for (size_t i = 0; i < f->n; ++i) {
+        int mudou = 1;
+        while (mudou && f->ins[i].op != M_NENHUM && f->ins[i].op != M_ROTULO
+               && f->ins[i].op != M_COMENTARIO) {
+            mudou = 0;
+            for (int k = 0; k < N_REGRAS && !mudou; ++k)
+                if (REGRAS[k].aplica(i)) {
+                    ++acertos[k];
+                    mudou = 1;
+                }
+        }
+    }
+
+    for (int k = 0; k < N_REGRAS; ++k) {
+        est_contador(REGRAS[k].contador, acertos[k]);
+        total += acertos[k];
+    }
+    fn = NULL;
+    return total;
+}
@@ -0,0 +1,17 @@
+/* ------------------------------------------------------------------
+ * janela.h  –  Otimização de janela (peephole) sobre a IR de cada
+ *              função, um dos passes de passes.c
+ * ------------------------------------------------------------------ */
+#ifndef JANELA_H
+#define JANELA_H
+
+#include "ir.h"
+
+/* Aplica as regras da tabela em janelas de poucas instruções da
+ * função inteira (prólogo, corpo e epílogo), com a vivacidade já
+ * calculada. Instruções removidas viram M_NENHUM. Cada regra tem um
+ * contador "janela.<nome>" no -ftime-report. Retorna quantas
+ * instruções foram alteradas ou removidas. */
+long otimiza_janela(FuncaoIR *f);
+
+#endif /* JANELA_H */
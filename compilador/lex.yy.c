@@ -546,14 +546,15 @@ char *yytext;
 #include <unistd.h>
 #include <string.h>
 #include "ast.h"
+#include "intern.h"
 #include "goianinha.tab.h"
 
 int linhacomentario = 0;
 
 #define YY_USER_ACTION  yylloc.first_line = yylloc.last_line = yylineno;
-#line 555 "lex.yy.c"
+#line 556 "lex.yy.c"
 
-#line 557 "lex.yy.c"
+#line 558 "lex.yy.c"
 
 #define INITIAL 0
 #define COMENTARIO 1
@@ -771,10 +772,10 @@ YY_DECL
 		}
 
 	{
-#line 23 "goianinha.l"
+#line 24 "goianinha.l"
 
 
-#line 778 "lex.yy.c"
+#line 779 "lex.yy.c"
 
 	while ( /*CONSTCOND*/1 )		/* loops until end-of-file is reached */
 		{
@@ -843,213 +844,213 @@ do_action:	/* This label is used only to access EOF actions. */
 
 case 1:
 YY_RULE_SETUP
-#line 25 "goianinha.l"
+#line 26 "goianinha.l"
 { return PROGRAMA; }
 	YY_BREAK
 case 2:
 YY_RULE_SETUP
-#line 26 "goianinha.l"
+#line 27 "goianinha.l"
 { return INT; }
 	YY_BREAK
 case 3:
 YY_RULE_SETUP
-#line 27 "goianinha.l"
+#line 28 "goianinha.l"
 { return CAR; }
 	YY_BREAK
 case 4:
 YY_RULE_SETUP
-#line 28 "goianinha.l"
+#line 29 "goianinha.l"
 { return RETORNE; }
 	YY_BREAK
 case 5:
 YY_RULE_SETUP
-#line 29 "goianinha.l"
+#line 30 "goianinha.l"
 { return LEIA; }
 	YY_BREAK
 case 6:
 YY_RULE_SETUP
-#line 30 "goianinha.l"
+#line 31 "goianinha.l"
 { return ESCREVA; }
 	YY_BREAK
 case 7:
 YY_RULE_SETUP
-#line 31 "goianinha.l"
+#line 32 "goianinha.l"
 { return NOVALINHA; }
 	YY_BREAK
 case 8:
 YY_RULE_SETUP
-#line 32 "goianinha.l"
+#line 33 "goianinha.l"
 { return SE; }
 	YY_BREAK
 case 9:
 YY_RULE_SETUP
-#line 33 "goianinha.l"
+#line 34 "goianinha.l"
 { return ENTAO; }
 	YY_BREAK
 case 10:
 YY_RULE_SETUP
-#line 34 "goianinha.l"
+#line 35 "goianinha.l"
 { return SENAO; }
 	YY_BREAK
 case 11:
 YY_RULE_SETUP
-#line 35 "goianinha.l"
+#line 36 "goianinha.l"
 { return ENQUANTO; }
 	YY_BREAK
 case 12:
 YY_RULE_SETUP
-#line 36 "goianinha.l"
+#line 37 "goianinha.l"
 { return EXECUTE; }
 	YY_BREAK
 case 13:
 YY_RULE_SETUP
-#line 37 "goianinha.l"
+#line 38 "goianinha.l"
 { return OU; }
 	YY_BREAK
 case 14:
 YY_RULE_SETUP
-#line 38 "goianinha.l"
+#line 39 "goianinha.l"
 { return E; }
 	YY_BREAK
 case 15:
 YY_RULE_SETUP
-#line 40 "goianinha.l"
+#line 41 "goianinha.l"
 { return EQ; }
 	YY_BREAK
 case 16:
 YY_RULE_SETUP
-#line 41 "goianinha.l"
+#line 42 "goianinha.l"
 { return NEQ; }
 	YY_BREAK
 case 17:
 YY_RULE_SETUP
-#line 42 "goianinha.l"
+#line 43 "goianinha.l"
 { return LEQ; }
 	YY_BREAK
 case 18:
 YY_RULE_SETUP
-#line 43 "goianinha.l"
+#line 44 "goianinha.l"
 { return GEQ; }
 	YY_BREAK
 case 19:
 YY_RULE_SETUP
-#line 45 "goianinha.l"
+#line 46 "goianinha.l"
 { return '+'; }
 	YY_BREAK
 case 20:
 YY_RULE_SETUP
-#line 46 "goianinha.l"
+#line 47 "goianinha.l"
 { return '-'; }
 	YY_BREAK
 case 21:
 YY_RULE_SETUP
-#line 47 "goianinha.l"
+#line 48 "goianinha.l"
 { return '*'; }
 	YY_BREAK
 case 22:
 YY_RULE_SETUP
-#line 48 "goianinha.l"
+#line 49 "goianinha.l"
 { return '/'; }
 	YY_BREAK
 case 23:
 YY_RULE_SETUP
-#line 49 "goianinha.l"
+#line 50 "goianinha.l"
 { return '('; }
 	YY_BREAK
 case 24:
 YY_RULE_SETUP
-#line 50 "goianinha.l"
+#line 51 "goianinha.l"
 { return ')'; }
 	YY_BREAK
 case 25:
 YY_RULE_SETUP
-#line 51 "goianinha.l"
+#line 52 "goianinha.l"
 { return '{'; }
 	YY_BREAK
 case 26:
 YY_RULE_SETUP
-#line 52 "goianinha.l"
+#line 53 "goianinha.l"
 { return '}'; }
 	YY_BREAK
 case 27:
 YY_RULE_SETUP
-#line 53 "goianinha.l"
+#line 54 "goianinha.l"
 { return ';'; }
 	YY_BREAK
 case 28:
 YY_RULE_SETUP
-#line 54 "goianinha.l"
+#line 55 "goianinha.l"
 { return ','; }
 	YY_BREAK
 case 29:
 YY_RULE_SETUP
-#line 55 "goianinha.l"
+#line 56 "goianinha.l"
 { return '<'; }
 	YY_BREAK
 case 30:
 YY_RULE_SETUP
-#line 56 "goianinha.l"
+#line 57 "goianinha.l"
 { return '>'; }
 	YY_BREAK
 case 31:
 YY_RULE_SETUP
-#line 57 "goianinha.l"
+#line 58 "goianinha.l"
 { return '='; }
 	YY_BREAK
 case 32:
 YY_RULE_SETUP
-#line 58 "goianinha.l"
+#line 59 "goianinha.l"
 { return '!'; }
 	YY_BREAK
 case 33:
 YY_RULE_SETUP
-#line 60 "goianinha.l"
-{ yylval.sval = strdup(yytext); return ID; }
+#line 61 "goianinha.l"
+{ yylval.sval = intern(yytext, yyleng); return ID; }
 	YY_BREAK
 case 34:
 YY_RULE_SETUP
-#line 61 "goianinha.l"
-{ yylval.sval = strdup(yytext); return INTCONST; }
+#line 62 "goianinha.l"
+{ yylval.sval = intern(yytext, yyleng); return INTCONST; }
 	YY_BREAK
 case 35:
 YY_RULE_SETUP
-#line 62 "goianinha.l"
-{ yylval.sval = strdup(yytext); return CARCONST; }
+#line 63 "goianinha.l"
+{ yylval.sval = intern(yytext, yyleng); return CARCONST; }
 	YY_BREAK
 case 36:
 YY_RULE_SETUP
-#line 63 "goianinha.l"
-{ yylval.sval = strdup(yytext); return STRING; }
+#line 64 "goianinha.l"
+{ yylval.sval = intern(yytext, yyleng); return STRING; }
 	YY_BREAK
 case 37:
 /* rule 37 can match eol */
 YY_RULE_SETUP
-#line 65 "goianinha.l"
+#line 66 "goianinha.l"
 ;
 	YY_BREAK
 case 38:
 YY_RULE_SETUP
-#line 67 "goianinha.l"
+#line 68 "goianinha.l"
 { BEGIN(COMENTARIO); linhacomentario = yylineno; }
 	YY_BREAK
 case 39:
 YY_RULE_SETUP
-#line 69 "goianinha.l"
+#line 70 "goianinha.l"
 { BEGIN(INITIAL); }
 	YY_BREAK
 case 40:
 /* rule 40 can match eol */
 YY_RULE_SETUP
-#line 71 "goianinha.l"
+#line 72 "goianinha.l"
 ;       
 	YY_BREAK
 case 41:
 YY_RULE_SETUP
-#line 73 "goianinha.l"
+#line 74 "goianinha.l"
 ;
 	YY_BREAK
 case YY_STATE_EOF(COMENTARIO):
-#line 74 "goianinha.l"
+#line 75 "goianinha.l"
 {
     fprintf(stderr,"ERRO: COMENTARIO NAO TERMINA %d\n", linhacomentario);
     BEGIN(INITIAL);
@@ -1058,31 +1059,31 @@ case YY_STATE_EOF(COMENTARIO):
 case 42:
 /* rule 42 can match eol */
 YY_RULE_SETUP
-#line 79 "goianinha.l"
+#line 80 "goianinha.l"
 {
     fprintf(stderr,"ERRO: cadeia de caracteres nao termina na linha %d\n", yylineno);
 }
 	YY_BREAK
 case 43:
 YY_RULE_SETUP
-#line 83 "goianinha.l"
+#line 84 "goianinha.l"
 ;
 	YY_BREAK
 case 44:
 YY_RULE_SETUP
-#line 85 "goianinha.l"
+#line 86 "goianinha.l"
 { fprintf(stderr,"ERRO: CARACTERE INVALIDO %d\n", yylineno); }
 	YY_BREAK
 case YY_STATE_EOF(INITIAL):
-#line 87 "goianinha.l"
+#line 88 "goianinha.l"
 { return 0; }
 	YY_BREAK
 case 45:
 YY_RULE_SETUP
-#line 88 "goianinha.l"
+#line 89 "goianinha.l"
 ECHO;
 	YY_BREAK
-#line 1086 "lex.yy.c"
+#line 1087 "lex.yy.c"
 
 	case YY_END_OF_BUFFER:
 		{
@@ -2097,4 +2098,4 @@ void yyfree (void * ptr )
 
 #define YYTABLES_NAME "yytables"
 
-#line 88 "goianinha.l"
+#line 89 "goianinha.l"
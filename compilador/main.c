@@ -1,58 +1,180 @@
 #include <stdio.h>
+#include <string.h>
 #include "ast.h"
+#include "intern.h"
+#include "fonte.h"
 #include "semantico.h"
+#include "otimiza.h"
+#include "passes.h"
 #include "codigo.h" // Adicionar a inclusão para gerar_codigo_mips
+#include "buffer_saida.h"
+#include "estatisticas.h"
 
 // "arvore_raiz" é definida em goianinha.y
 extern AST *arvore_raiz;
+extern int yylineno;
 
-extern FILE *yyin;
 int yyparse(void);
 
+static void uso(const char *prog)
+{
+    fprintf(stderr,
+            "Uso: %s [opções] <fonte.txt>\n"
+            "  -o ARQ                  grava o assembly em ARQ (\"-\" = saída padrão;\n"
+            "                          padrão: saida.s)\n"
+            "  -fsyntax-only           para depois da análise semântica\n"
+            "  -O0 | -O1 | -O2         nível de otimização (padrão: -O2); -O0 não\n"
+            "                          otimiza, -O1 dobra constantes e roda a\n"
+            "                          janela, -O2 acrescenta os passes de fluxo\n"
+            "  --dump-ast              imprime a AST na saída padrão\n"
+            "  -v                      informa o andamento das fases em stderr\n"
+            "  -ftime-report           tempo e memória por fase, em stderr\n"
+            "  -ftime-report-json=ARQ  o mesmo relatório em JSON (\"-\" = saída padrão)\n",
+            prog);
+}
+
 int main(int argc, char **argv)
 {
-    if (argc < 2)
+    const char *caminho = NULL;
+    const char *saida = "saida.s";      /* -o ARQ                    */
+    int so_sintaxe = 0;                 /* -fsyntax-only             */
+    int despeja_ast = 0;                /* --dump-ast                */
+    int verboso = 0;                    /* -v                        */
+    int relatorio = 0;                  /* -ftime-report             */
+    const char *relatorio_json = NULL;  /* -ftime-report-json=ARQ    */
+
+    for (int i = 1; i < argc; ++i)
     {
-        fprintf(stderr, "Uso: %s <fonte.go>\n", argv[0]);
-        return 1;
+        const char *a = argv[i];
+        if (strcmp(a, "-o") == 0 && i + 1 < argc)
+            saida = argv[++i];
+        else if (strcmp(a, "-fsyntax-only") == 0)
+            so_sintaxe = 1;
+        else if (a[0] == '-' && a[1] == 'O' && a[2] >= '0' && a[2] <= '2' && a[3] == '\0')
+            passes_nivel(a[2] - '0');
+        else if (strcmp(a, "--dump-ast") == 0)
+            despeja_ast = 1;
+        else if (strcmp(a, "-v") == 0)
+            verboso = 1;
+        else if (strcmp(a, "-ftime-report") == 0)
+            relatorio = 1;
+        else if (strncmp(a, "-ftime-report-json=", 19) == 0)
+            relatorio_json = a + 19;
+        else if (a[0] == '-' && a[1] != '\0')
+        {
+            fprintf(stderr, "ERRO: opção desconhecida '%s'\n", a);
+            uso(argv[0]);
+            return 1;
+        }
+        else if (!caminho)
+            caminho = a;
+        else
+        {
+            uso(argv[0]);
+            return 1;
+        }
     }
-    yyin = fopen(argv[1], "r");
-    if (!yyin)
+    if (!caminho)
     {
-        perror("falha abrindo arquivo");
+        uso(argv[0]);
         return 1;
     }
+    if (relatorio || relatorio_json)
+        est_ativa();
+
+    Fonte fonte;
+    if (!fonte_abre(&fonte, caminho))
+        return 1;
 
+    est_entra(FASE_SINTATICO);
     int r = yyparse();
+    est_linhas(yylineno);
+    if (r != 0)
+        est_sai(FASE_SINTATICO);
     if (r == 0)
     {
-        if (arvore_raiz)
+        /* achata a árvore do parser; as fases seguintes usam só a
+         * versão compacta, então a arena da AST já pode ser liberada */
+        size_t bytes_ponteiros = ast_bytes();
+        ASTC *arvore = ast_compacta(arvore_raiz);
+        est_conta(FASE_SINTATICO, arvore->n_nos);
+        est_sai(FASE_SINTATICO);
+        ast_libera(arvore_raiz);
+        arvore_raiz = NULL;
+
+        if (despeja_ast)
         {
-            puts("--------- AST ---------");
-            ast_imprime(arvore_raiz, 0);
+            BufferSaida b;
+            bs_abre_fd(&b, 1);
+            astc_despeja(arvore, &b);
+            bs_fecha(&b);
         }
+        if (verboso && arvore->n_nos)
+            fprintf(stderr, "AST: %u nós; árvore do parser %zu bytes (%.1f B/nó); "
+                            "compacta %zu bytes (%.1f B/nó)\n",
+                    arvore->n_nos,
+                    bytes_ponteiros, (double)bytes_ponteiros / arvore->n_nos,
+                    astc_bytes(arvore), (double)astc_bytes(arvore) / arvore->n_nos);
 
-        if (analise_semanica(arvore_raiz))
+        est_entra(FASE_SEMANTICO);
+        int sem_ok = analise_semanica(arvore);
+        est_conta(FASE_SEMANTICO, arvore->n_nos);
+        est_sai(FASE_SEMANTICO);
+        if (!sem_ok)
         {
-            puts("Compilado com sucesso (fase semântica)");
-            
-            if (gerar_codigo_mips(arvore_raiz, "saida.s"))
-            {
-                puts("Compilado com sucesso (fase semântica + código)");
-            }
-            else
-            {
-                fprintf(stderr, "ERRO: Falha ao gerar o código de saída.\n");
-                r = 1;
-            }
+            fprintf(stderr, "ERRO: Falha na análise semântica.\n");
+            r = 1;
         }
         else
         {
-            fprintf(stderr, "ERRO: Falha na análise semântica.\n");
-            r = 1;
+            if (verboso)
+                fputs("Compilado com sucesso (fase semântica)\n", stderr);
+
+            if (!so_sintaxe)
+            {
+                long simplificados = 0;
+                if (passes_nivel_atual() >= 1)
+                {
+                    est_entra(FASE_OTIMIZACAO);
+                    simplificados = otimiza_expressoes(arvore);
+                    est_sai(FASE_OTIMIZACAO);
+                }
+                if (verboso)
+                    fprintf(stderr, "Otimização: %ld operadores eliminados\n", simplificados);
+
+                est_entra(FASE_CODIGO);
+                int cod_ok = gerar_codigo_mips(arvore, saida);
+                est_sai(FASE_CODIGO);
+                if (!cod_ok)
+                {
+                    fprintf(stderr, "ERRO: Falha ao gerar o código de saída.\n");
+                    r = 1;
+                }
+                else if (verboso)
+                {
+                    fputs("Compilado com sucesso (fase semântica + código)\n", stderr);
+                }
+            }
         }
 
-        ast_libera(arvore_raiz);
+        astc_libera(arvore);
+    }
+    fonte_fecha(&fonte);
+    intern_libera();
+
+    if (relatorio)
+        est_relatorio(stderr);
+    if (relatorio_json)
+    {
+        FILE *f = strcmp(relatorio_json, "-") == 0 ? stdout : fopen(relatorio_json, "w");
+        if (!f)
+        {
+            perror(relatorio_json);
+            return 1;
+        }
+        est_relatorio_json(f, caminho);
+        if (f != stdout)
+            fclose(f);
     }
     return r;
-}
\ No newline at end of file
+}
@@ -0,0 +1,134 @@
+/* =====================================================================
+ * morto.c  ─  Código morto: registradores, escritas no quadro e
+ *             palavras do quadro sem uso
+ * ===================================================================== */
+#include "morto.h"
+#include <string.h>
+
+#define R_SP 29
+#define R_FP 30
+#define WORD_SIZE 4
+#define SEM_USO UINT32_MAX
+
+/* ------------------------------------------------------------------ */
+/* Registradores                                                      */
+/* ------------------------------------------------------------------ */
+// De trás para a frente em cada bloco, a partir dos vivos na saída:
+// uma instrução removida não torna vivo o que ela lia, então as
+// cadeias inteiras de um bloco saem numa passada só
+// ('li $t0, 5 / add $t1, $t0, $s0 / move $s2, $t1' com $s2 morto).
+static int removivel(const Instr *in) {
+    return ir_classe(in) == CL_NORMAL && !(in->op == M_DIV && in->n == 3)
+        && ir_escreve(in) != 0;
+}
+
+long codigo_morto(FuncaoIR *f) {
+    long removidas = 0;
+    for (size_t k = 0; k < f->n_blocos; ++k) {
+        const Bloco *b = &f->blocos[k];
+        uint32_t vivo = b->sai;
+        for (uint32_t i = b->fim; i-- > b->ini; ) {
+            Instr *in = &f->ins[i];
+            if (removivel(in) && !(ir_escreve(in) & vivo)) {
+                in->op = M_NENHUM;
+                ++removidas;
+                continue;
+            }
+            vivo = (vivo & ~ir_escreve(in)) | ir_le(in);
+        }
+    }
+    return removidas;
+}
+
+/* ------------------------------------------------------------------ */
+/* Escritas no quadro                                                 */
+/* ------------------------------------------------------------------ */
+static int no_quadro(const Operando *o) {
+    return o->tipo == O_MEM && (o->reg == R_SP || o->reg == R_FP) && o->valor >= 0;
+}
+
+// Palavras do quadro acessadas por lw (ou por qualquer acesso); devolve
+// quantas palavras vão até o maior deslocamento visto
+static size_t palavras_do_quadro(const FuncaoIR *f) {
+    size_t n = 0;
+    for (size_t i = 0; i < f->n; ++i) {
+        const Instr *in = &f->ins[i];
+        if ((in->op == M_LW || in->op == M_SW) && no_quadro(&in->a[1])
+            && (size_t)in->a[1].valor / WORD_SIZE + 1 > n)
+            n = (size_t)in->a[1].valor / WORD_SIZE + 1;
+    }
+    return n;
+}
+
+#define RECENTES 8                  // sw de um bloco ainda não lidos
+
+long escritas_mortas(FuncaoIR *f) {
+    size_t n_pal = palavras_do_quadro(f);
+    uint32_t *lida = ir_trabalho(f, n_pal + 1);
+    memset(lida, 0, (n_pal + 1) * sizeof *lida);
+    for (size_t i = 0; i < f->n; ++i)
+        if (f->ins[i].op == M_LW && no_quadro(&f->ins[i].a[1]))
+            lida[f->ins[i].a[1].valor / WORD_SIZE] = 1;
+
+    long removidas = 0;
+    for (size_t k = 0; k < f->n_blocos; ++k) {
+        const Bloco *b = &f->blocos[k];
+        int32_t recentes[RECENTES];
+        int n_recentes = 0;
+        for (uint32_t i = b->fim; i-- > b->ini; ) {
+            Instr *in = &f->ins[i];
+            if ((in->op != M_LW && in->op != M_SW) || !no_quadro(&in->a[1])) continue;
+            int32_t desl = in->a[1].valor;
+            int j = 0;
+            while (j < n_recentes && recentes[j] != desl) ++j;
+            if (in->op == M_LW) {
+                if (j < n_recentes) recentes[j] = recentes[--n_recentes];
+            } else if (!lida[desl / WORD_SIZE] || j < n_recentes) {
+                in->op = M_NENHUM;
+                ++removidas;
+            } else if (n_recentes < RECENTES) {
+                recentes[n_recentes++] = desl;
+            }
+        }
+    }
+    return removidas;
+}
+
+/* ------------------------------------------------------------------ */
+/* Quadro                                                             */
+/* ------------------------------------------------------------------ */
+static int ajusta_sp(const Instr *in) {
+    return in->op == M_ADDI && in->a[0].reg == R_SP && in->a[1].reg == R_SP
+        && in->a[2].tipo == O_IMED;
+}
+
+long quadro_compacto(FuncaoIR *f) {
+    size_t i = 0;
+    while (i < f->n && !ajusta_sp(&f->ins[i])) ++i;
+    if (i == f->n || f->ins[i].a[2].valor >= 0) return 0;
+    size_t n_pal = (size_t)-f->ins[i].a[2].valor / WORD_SIZE;
+    if (palavras_do_quadro(f) > n_pal) return 0;        // não é o quadro esperado
+
+    // novo deslocamento de cada palavra usada; $ra e $fp ficam no lugar
+    uint32_t *novo = ir_trabalho(f, n_pal + 2);
+    for (size_t w = 0; w < n_pal; ++w) novo[w] = w < 2 ? 0 : SEM_USO;
+    for (size_t k = 0; k < f->n; ++k) {
+        const Instr *in = &f->ins[k];
+        if ((in->op == M_LW || in->op == M_SW) && no_quadro(&in->a[1]))
+            novo[in->a[1].valor / WORD_SIZE] = 0;
+    }
+    size_t usadas = 0;
+    for (size_t w = 0; w < n_pal; ++w)
+        if (novo[w] != SEM_USO) novo[w] = (uint32_t)(usadas++ * WORD_SIZE);
+    if (usadas == n_pal) return 0;
+
+    for (size_t k = 0; k < f->n; ++k) {
+        Instr *in = &f->ins[k];
+        if ((in->op == M_LW || in->op == M_SW) && no_quadro(&in->a[1]))
+            in->a[1].valor = (int32_t)novo[in->a[1].valor / WORD_SIZE];
+        else if (ajusta_sp(in))
+            in->a[2].valor = in->a[2].valor < 0 ? -(int32_t)(usadas * WORD_SIZE)
+                                                : (int32_t)(usadas * WORD_SIZE);
+    }
+    return (long)(n_pal - usadas);
+}
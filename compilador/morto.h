@@ -0,0 +1,27 @@
+/* ------------------------------------------------------------------
+ * morto.h  –  Eliminação de código morto sobre a IR de cada função:
+ *             definições que ninguém lê, escritas no quadro que
+ *             ninguém relê e palavras do quadro que ficaram sem uso
+ * ------------------------------------------------------------------ */
+#ifndef MORTO_H
+#define MORTO_H
+
+#include "ir.h"
+
+/* Tira as instruções que só escrevem registradores mortos logo depois
+ * delas (exige a vivacidade). div de três operandos fica: ela testa a
+ * divisão por zero. Retorna quantas saíram. */
+long codigo_morto(FuncaoIR *f);
+
+/* Tira os sw no quadro ($sp/$fp) para palavras que nenhum lw da função
+ * lê, e os que outro sw no mesmo bloco sobrescreve antes de qualquer
+ * leitura (exige o CFG). Retorna quantos saíram. */
+long escritas_mortas(FuncaoIR *f);
+
+/* Renumera as palavras do quadro que ainda são acessadas, fechando os
+ * buracos, e corrige o addi de $sp do prólogo e do epílogo. Supõe o
+ * quadro de codigo.c: $sp == $fp no corpo e todo acesso é lw/sw com
+ * deslocamento constante. Retorna quantas palavras o quadro perdeu. */
+long quadro_compacto(FuncaoIR *f);
+
+#endif /* MORTO_H */
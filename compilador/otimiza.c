@@ -0,0 +1,180 @@
+/* =====================================================================
+ * otimiza.c  ─  Dobramento de constantes e simplificação algébrica
+ *               das expressões, na AST compacta já anotada
+ * ===================================================================== */
+#include "otimiza.h"
+#include "tabela_simbolos.h"
+#include "estatisticas.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+/* AST compacta em otimização e atalhos de acesso aos nós */
+static ASTC *arv;
+
+#define TIPO(n)      NO_TIPO(arv, n)
+#define OP(n)        NO_OP(arv, n)
+#define NFILHOS(n)   NO_NFILHOS(arv, n)
+#define FILHO(n, k)  NO_FILHO(arv, n, k)
+#define ANOT(n)      NO_ANOT(arv, n)
+#define VALOR(n)     NO_LITERAL(arv, n)
+#define LITERAL(n)   (TIPO(n) == AST_INT || TIPO(n) == AST_CAR)
+
+static uint8_t *impuro;     // subárvore chama função ou atribui
+static long n_dobras, n_identidades;
+
+// Calcula 'a op b' (ou 'op a'); 0 se o resultado não cabe em 32 bits
+// ou a conta não pode ser feita agora (divisão por zero fica para a
+// execução). 'e' e 'ou' são lógicos: o resultado é 0 ou 1.
+static int calcula(OpCode op, int64_t a, int64_t b, int32_t *r) {
+    int64_t v;
+    switch (op) {
+        case OP_SOMA:          v = a + b; break;
+        case OP_SUB:           v = a - b; break;
+        case OP_MUL:           v = a * b; break;
+        case OP_DIV:
+            if (b == 0) return 0;
+            v = a / b;
+            break;
+        case OP_MENOR:         v = a < b; break;
+        case OP_MAIOR:         v = a > b; break;
+        case OP_MENOR_IGUAL:   v = a <= b; break;
+        case OP_MAIOR_IGUAL:   v = a >= b; break;
+        case OP_IGUAL:         v = a == b; break;
+        case OP_DIFERENTE:     v = a != b; break;
+        case OP_E:             v = a && b; break;
+        case OP_OU:            v = a || b; break;
+        case OP_NEG:           v = -a; break;
+        case OP_NAO:           v = !a; break;
+        default:               return 0;
+    }
+    if (v < INT32_MIN || v > INT32_MAX) return 0;
+    *r = (int32_t)v;
+    return 1;
+}
+
+// n passa a ser o literal v (do tipo que a análise semântica deu a n)
+static void vira_literal(NoId n, int32_t v) {
+    NoC *no = &arv->nos[n];
+    no->tipo = ANOT(n).tipo == TIPO_CAR ? AST_CAR : AST_INT;
+    no->op = OP_NENHUM;
+    no->literal = 1;
+    no->valor = (uint32_t)v;
+    no->n_filhos = 0;
+    impuro[n] = 0;
+    ++n_dobras;
+}
+
+// n passa a ser uma cópia do seu operando 'filho' (que sai da árvore);
+// a linha de n não muda
+static void vira_operando(NoId n, NoId filho) {
+    int16_t dlinha = arv->nos[n].dlinha;
+    arv->nos[n] = arv->nos[filho];
+    arv->nos[n].dlinha = dlinha;
+    ANOT(n) = ANOT(filho);
+    impuro[n] = impuro[filho];
+    ++n_identidades;
+}
+
+static int eh_literal(NoId n, int32_t v) {
+    return LITERAL(n) && VALOR(n) == v;
+}
+
+// Mesma variável dos dois lados (sem efeitos entre as leituras)
+static int mesma_variavel(NoId a, NoId b) {
+    return TIPO(a) == AST_ID && TIPO(b) == AST_ID
+        && ANOT(a).lugar == ANOT(b).lugar && ANOT(a).slot == ANOT(b).slot;
+}
+
+static void simplifica_unario(NoId n) {
+    NoId a = FILHO(n, 0);
+    int32_t v;
+    if (LITERAL(a) && calcula(OP(n), VALOR(a), 0, &v)) {
+        vira_literal(n, v);
+    } else if (OP(n) == OP_NEG && TIPO(a) == AST_OP && OP(a) == OP_NEG
+               && NFILHOS(a) == 1) {
+        vira_operando(n, FILHO(a, 0));                  // -(-x)
+    }
+}
+
+static void simplifica_binario(NoId n) {
+    NoId a = FILHO(n, 0), b = FILHO(n, 1);
+    int32_t v;
+    if (LITERAL(a) && LITERAL(b)) {
+        if (calcula(OP(n), VALOR(a), VALOR(b), &v)) vira_literal(n, v);
+        return;
+    }
+    switch (OP(n)) {
+        case OP_SOMA:
+            if (eh_literal(a, 0)) vira_operando(n, b);
+            else if (eh_literal(b, 0)) vira_operando(n, a);
+            break;
+        case OP_SUB:
+            if (eh_literal(b, 0)) {
+                vira_operando(n, a);
+            } else if (eh_literal(a, 0)) {              // 0 - x = -x
+                arv->nos[n].op = OP_NEG;
+                arv->nos[n].n_filhos = 1;
+                arv->filhos[arv->nos[n].filhos] = b;
+                ++n_identidades;
+                simplifica_unario(n);
+            } else if (mesma_variavel(a, b)) {
+                vira_literal(n, 0);
+            }
+            break;
+        case OP_MUL:
+            if (eh_literal(a, 1)) vira_operando(n, b);
+            else if (eh_literal(b, 1)) vira_operando(n, a);
+            else if ((eh_literal(a, 0) && !impuro[b]) || (eh_literal(b, 0) && !impuro[a]))
+                vira_literal(n, 0);
+            break;
+        case OP_DIV:
+            if (eh_literal(b, 1)) vira_operando(n, a);
+            break;
+        case OP_E:
+            // o lado direito de 'e' não é avaliado se o esquerdo é falso
+            if (eh_literal(a, 0) || (eh_literal(b, 0) && !impuro[a]))
+                vira_literal(n, 0);
+            break;
+        case OP_OU:
+            if ((LITERAL(a) && VALOR(a) != 0) || (LITERAL(b) && VALOR(b) != 0 && !impuro[a]))
+                vira_literal(n, 1);
+            break;
+        case OP_IGUAL: case OP_MENOR_IGUAL: case OP_MAIOR_IGUAL:
+            if (mesma_variavel(a, b)) vira_literal(n, 1);
+            break;
+        case OP_DIFERENTE: case OP_MENOR: case OP_MAIOR:
+            if (mesma_variavel(a, b)) vira_literal(n, 0);
+            break;
+        default:
+            break;
+    }
+}
+
+long otimiza_expressoes(ASTC *a) {
+    if (!a || !a->n_nos || !a->anot) return 0;
+    arv = a;
+    impuro = calloc(arv->n_nos, 1);
+    if (!impuro) {
+        fprintf(stderr, "ERRO: memória insuficiente na otimização.\n");
+        exit(1);
+    }
+    n_dobras = n_identidades = 0;
+
+    // Os filhos vêm depois do pai na pré-ordem: de trás para a frente,
+    // cada operador já encontra os operandos simplificados
+    for (NoId n = arv->n_nos; n-- > 0; ) {
+        uint8_t f = TIPO(n) == AST_CHAMADA_FUNCAO || TIPO(n) == AST_ATRIB;
+        for (int k = 0; k < NFILHOS(n); ++k) f |= impuro[FILHO(n, k)];
+        impuro[n] = f;
+        if (TIPO(n) != AST_OP) continue;
+        if (NFILHOS(n) == 1) simplifica_unario(n);
+        else simplifica_binario(n);
+    }
+
+    free(impuro);
+    impuro = NULL;
+    est_contador("otimizacao.constantes_dobradas", n_dobras);
+    est_contador("otimizacao.identidades_aplicadas", n_identidades);
+    est_conta(FASE_OTIMIZACAO, n_dobras + n_identidades);
+    return n_dobras + n_identidades;
+}
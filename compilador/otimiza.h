@@ -0,0 +1,19 @@
+/* ------------------------------------------------------------------
+ * otimiza.h  –  Otimizações na AST compacta, entre a análise
+ *               semântica e a geração de código
+ * ------------------------------------------------------------------ */
+#ifndef OTIMIZA_H
+#define OTIMIZA_H
+
+#include "ast.h"
+
+/* Dobra as subexpressões constantes e aplica identidades algébricas
+ * (x+0, x*1, x*0, 0-x, x-x, -(-x), ...). A árvore é alterada no lugar:
+ * um nó dobrado vira literal sem filhos e um nó simplificado para um
+ * dos operandos recebe uma cópia dele. Os nós que saem da árvore
+ * continuam no vetor, então depois desta passada os percursos devem
+ * seguir os filhos, e não a sequência dos índices.
+ * Retorna quantos nós de operador foram eliminados. */
+long otimiza_expressoes(ASTC *arv);
+
+#endif /* OTIMIZA_H */
@@ -0,0 +1,133 @@
+/* =====================================================================
+ * passes.c  ─  Sequência de passes sobre a IR de cada função e os
+ *              passes de fluxo de controle
+ * ===================================================================== */
+#include "passes.h"
+#include "janela.h"
+#include "morto.h"
+#include "estatisticas.h"
+
+static int nivel = 2;
+
+void passes_nivel(int n) {
+    nivel = n;
+}
+
+int passes_nivel_atual(void) {
+    return nivel;
+}
+
+/* ------------------------------------------------------------------ */
+/* Saltos encadeados                                                  */
+/* ------------------------------------------------------------------ */
+// Um desvio ou salto para L, onde a primeira instrução depois de L é
+// 'j M', vai direto para M ('senao' que termina num laço, 'retorne'
+// dentro de 'se' aninhado...). O 'j M' que sobrar sem ninguém chegando
+// nele sai em blocos_inalcancaveis.
+#define MAX_ELOS 8                  // contra ciclos de saltos
+
+// Primeira instrução que executa depois do rótulo id, ou f->n
+static size_t depois_do_rotulo(const FuncaoIR *f, int id) {
+    if (id < f->rotulo_min || id >= f->rotulo_max) return f->n;
+    int32_t b = f->bloco_do_rotulo[id - f->rotulo_min];
+    if (b < 0) return f->n;
+    size_t i = f->blocos[b].ini;
+    while (i < f->n && (f->ins[i].op == M_ROTULO || f->ins[i].op == M_COMENTARIO
+                        || f->ins[i].op == M_NENHUM))
+        ++i;
+    return i;
+}
+
+static long salto_encadeado(FuncaoIR *f) {
+    long mudancas = 0;
+    for (size_t i = 0; i < f->n; ++i) {
+        Instr *in = &f->ins[i];
+        ClasseInstr c = ir_classe(in);
+        if (c != CL_SALTO && c != CL_DESVIO) continue;
+        int alvo = ir_alvo(in), novo = alvo;
+        for (int elo = 0; elo < MAX_ELOS; ++elo) {
+            size_t k = depois_do_rotulo(f, novo);
+            if (k == f->n || f->ins[k].op != M_J || ir_alvo(&f->ins[k]) == novo) break;
+            novo = ir_alvo(&f->ins[k]);
+        }
+        if (novo != alvo) {
+            in->a[in->n - 1].valor = novo;
+            ++mudancas;
+        }
+    }
+    return mudancas;
+}
+
+/* ------------------------------------------------------------------ */
+/* Blocos inalcançáveis                                               */
+/* ------------------------------------------------------------------ */
+// Busca a partir do primeiro bloco pelos sucessores do CFG; o que não
+// foi alcançado sai (código depois de 'retorne', saltos que
+// salto_encadeado deixou sem uso). Comentários ficam.
+static long blocos_inalcancaveis(FuncaoIR *f) {
+    size_t nb = f->n_blocos;
+    if (nb == 0) return 0;
+    uint32_t *visto = ir_trabalho(f, 2 * nb), *pilha = visto + nb;
+    for (size_t k = 0; k < nb; ++k) visto[k] = 0;
+    size_t n_pilha = 0;
+    visto[0] = 1;
+    pilha[n_pilha++] = 0;
+    while (n_pilha) {
+        const Bloco *b = &f->blocos[pilha[--n_pilha]];
+        for (int s = 0; s < 2; ++s)
+            if (b->suc[s] >= 0 && !visto[b->suc[s]]) {
+                visto[b->suc[s]] = 1;
+                pilha[n_pilha++] = (uint32_t)b->suc[s];
+            }
+    }
+
+    long removidas = 0;
+    for (size_t k = 0; k < nb; ++k) {
+        if (visto[k]) continue;
+        for (uint32_t i = f->blocos[k].ini; i < f->blocos[k].fim; ++i) {
+            Instr *in = &f->ins[i];
+            if (in->op == M_COMENTARIO || in->op == M_NENHUM) continue;
+            if (in->op != M_ROTULO) ++removidas;
+            in->op = M_NENHUM;
+        }
+    }
+    return removidas;
+}
+
+/* ------------------------------------------------------------------ */
+/* Tabela de passes                                                   */
+/* ------------------------------------------------------------------ */
+enum { A_CFG = 1, A_VIVACIDADE = 2 };
+
+static const struct {
+    const char *nome;
+    int nivel;                      // menor -O em que o passe roda
+    int requer;                     // análises A_*
+    long (*executa)(FuncaoIR *f);
+} PASSES[] = {
+    { "salto_encadeado",      2, A_CFG,        salto_encadeado },
+    { "blocos_inalcancaveis", 2, A_CFG,        blocos_inalcancaveis },
+    { "janela",               1, A_VIVACIDADE, otimiza_janela },
+    { "escritas_mortas",      2, A_CFG,        escritas_mortas },
+    { "codigo_morto",         2, A_VIVACIDADE, codigo_morto },
+    { "quadro_compacto",      2, 0,            quadro_compacto },
+};
+#define N_PASSES ((int)(sizeof PASSES / sizeof PASSES[0]))
+
+long passes_executa(FuncaoIR *f) {
+    long total = 0;
+    est_entra(FASE_PASSES);
+    for (int p = 0; p < N_PASSES; ++p) {
+        if (PASSES[p].nivel > nivel) continue;
+        double inicio = est_relogio();
+        if ((PASSES[p].requer & A_CFG) && !f->tem_cfg) ir_cfg(f);
+        if ((PASSES[p].requer & A_VIVACIDADE) && !f->tem_vivos) ir_vivacidade(f);
+        long mudancas = PASSES[p].executa(f);
+        if (mudancas) ir_compacta(f);
+        est_passo(PASSES[p].nome, est_relogio() - inicio, mudancas);
+        total += mudancas;
+    }
+    est_conta(FASE_PASSES, total);
+    est_sai(FASE_PASSES);
+    return total;
+}
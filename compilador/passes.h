@@ -0,0 +1,25 @@
+/* ------------------------------------------------------------------
+ * passes.h  –  Gerenciador de passes: a sequência de transformações
+ *              sobre a IR de cada função, escolhida pelo nível -O
+ * ------------------------------------------------------------------ */
+#ifndef PASSES_H
+#define PASSES_H
+
+#include "ir.h"
+
+/* -O0: nenhum passe (e main.c não dobra constantes na AST)
+ * -O1: janela
+ * -O2: salto_encadeado, blocos_inalcancaveis, janela, escritas_mortas,
+ *      codigo_morto e quadro_compacto (padrão); codigo.c também deixa
+ *      de gerar os ramos de 'se'/'enquanto' com condição constante */
+void passes_nivel(int nivel);
+int  passes_nivel_atual(void);
+
+/* Roda os passes do nível sobre f, na ordem da tabela. Antes de cada
+ * passe calcula as análises que ele pede e ainda não estão em dia;
+ * depois de um passe que mudou alguma coisa, tira as instruções
+ * apagadas e invalida as análises. Cada passe tem o tempo e as
+ * mudanças somados no -ftime-report. Retorna o total de mudanças. */
+long passes_executa(FuncaoIR *f);
+
+#endif /* PASSES_H */
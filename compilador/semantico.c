@@ -21,14 +21,24 @@ static void erro_semantico(int linha, const char *fmt, ...)
     exit(1);
 }
 
+/* AST compacta em análise e atalhos de acesso aos nós */
+static ASTC *arv;
+
+#define TIPO(n)      NO_TIPO(arv, n)
+#define NFILHOS(n)   NO_NFILHOS(arv, n)
+#define FILHO(n, k)  NO_FILHO(arv, n, k)
+#define NOME(n)      astc_nome(arv, n)
+#define LINHA(n)     astc_linha(arv, n)
+#define ANOT(n)      NO_ANOT(arv, n)
+
 /* Converte nó AST_INT / AST_CAR em Tipo (enum da tabela) */
-static Tipo tipo_do_no(AST *noTipo)
+static Tipo tipo_do_no(NoId noTipo)
 {
-    if (!noTipo)
+    if (noTipo == NO_NULO)
         return TIPO_INT; /* default impossível */
-    if (noTipo->tipo == AST_INT)
+    if (TIPO(noTipo) == AST_INT)
         return TIPO_INT;
-    if (noTipo->tipo == AST_CAR)
+    if (TIPO(noTipo) == AST_CAR)
         return TIPO_CAR;
     return TIPO_INT;
 }
@@ -40,317 +50,496 @@ static Tipo tipo_do_no(AST *noTipo)
 static Tipo tipoFuncaoAtual = TIPO_INT; /* tipo de retorno da função em análise */
 
 /* ========================================================= */
-/*  Declarações adiantadas                                   */
+/*  Frame da função em análise                               */
 /* ========================================================= */
+/* Layout (deslocamentos a partir de $fp, que aponta para o topo da
+ * pilha depois do prólogo):
+ *      0   $ra salvo
+ *      4   $fp anterior
+ *      8   parâmetros, 4 bytes cada, na ordem da declaração
+ *      ... locais; blocos irmãos reaproveitam as mesmas posições
+ * Tudo fica acima de $sp, então chamadas não sobrescrevem o frame. */
+#define WORD_SIZE 4
+#define SLOT_PARAMETROS 8
+
+static int proximoSlot = 0; /* primeira posição livre para um local */
+static int maiorSlot = 0;   /* fim do frame (maior proximoSlot visto) */
+
+static void inicia_frame(int nParams)
+{
+    proximoSlot = maiorSlot = SLOT_PARAMETROS + nParams * WORD_SIZE;
+}
 
-static Tipo verifica_expr(AST *expr);
-static void verifica_comando(AST *cmd);
-static void percorre_bloco(AST *bloco);
+static int slot_parametro(int pos)
+{
+    return SLOT_PARAMETROS + pos * WORD_SIZE;
+}
+
+/* Grava em 'n' onde mora o símbolo s */
+static void anota_nome(NoId n, const Simbolo *s)
+{
+    ANOT(n).tipo = (uint8_t)s->tipo;
+    switch (s->categoria)
+    {
+    case FUNCAO:
+        ANOT(n).lugar = LUGAR_FUNCAO;
+        ANOT(n).slot = s->posicao;
+        break;
+    case PARAMETRO:
+        ANOT(n).lugar = LUGAR_FRAME;
+        ANOT(n).slot = slot_parametro(s->posicao);
+        break;
+    case VARIAVEL:
+        ANOT(n).lugar = s->escopo == 0 ? LUGAR_GLOBAL : LUGAR_FRAME;
+        ANOT(n).slot = s->posicao;
+        break;
+    }
+}
 
 /* ========================================================= */
-/*  Verificação de expressões                               */
+/*  Classes de operadores (regra de tipos por OpCode)        */
 /* ========================================================= */
 
-static Tipo verifica_operador_binario(AST *no, Tipo esperado)
+typedef enum { OPC_ARITMETICO, OPC_RELACIONAL, OPC_LOGICO, OPC_UNARIO } ClasseOp;
+
+static const unsigned char CLASSE_OP[N_OPS] = {
+    [OP_SOMA] = OPC_ARITMETICO, [OP_SUB] = OPC_ARITMETICO,
+    [OP_MUL] = OPC_ARITMETICO,  [OP_DIV] = OPC_ARITMETICO,
+    [OP_MENOR] = OPC_RELACIONAL, [OP_MAIOR] = OPC_RELACIONAL,
+    [OP_MENOR_IGUAL] = OPC_RELACIONAL, [OP_MAIOR_IGUAL] = OPC_RELACIONAL,
+    [OP_IGUAL] = OPC_RELACIONAL, [OP_DIFERENTE] = OPC_RELACIONAL,
+    [OP_E] = OPC_LOGICO, [OP_OU] = OPC_LOGICO,
+    [OP_NEG] = OPC_UNARIO, [OP_NAO] = OPC_UNARIO,
+};
+
+/* ========================================================= */
+/*  Pilhas de trabalho                                       */
+/* ========================================================= */
+/* Os percursos não são recursivos: cada passo vira uma tarefa numa
+ * pilha explícita, e os tipos já calculados das subexpressões ficam
+ * numa pilha de valores. Assim a profundidade da árvore (blocos
+ * aninhados, expressões longas) não consome a pilha de C. As tarefas
+ * são empilhadas na ordem inversa da execução. */
+
+typedef enum
+{
+    T_COMANDO,      /* visita um comando                              */
+    T_EXPR,         /* visita uma expressão: resolve e empilha filhos */
+    T_EXPR_FIM,     /* filhos já avaliados: combina os tipos          */
+    T_DESCARTA,     /* descarta o tipo de uma expressão-comando       */
+    T_RETORNE,      /* confere o tipo do retorne                      */
+    T_FECHA_BLOCO,  /* fecha o escopo; aux = proximoSlot de antes     */
+} Passo;
+
+typedef struct
 {
-    Tipo esq = verifica_expr(no->filhos[0]);
-    Tipo dir = verifica_expr(no->filhos[1]);
+    NoId    no;
+    uint8_t passo;
+    int     aux;
+} Tarefa;
 
-    if (esq != dir)
-        erro_semantico(no->linha, "tipos incompatíveis no operador %s", no->valor);
+static Tarefa *tarefas = NULL;
+static size_t n_tarefas = 0, cap_tarefas = 0;
+static uint8_t *tipos = NULL; /* pilha de Tipo */
+static size_t n_tipos = 0, cap_tipos = 0;
 
-    if (esperado != esq) /* para +,-,*,/ esperam int */
-        erro_semantico(no->linha, "operador %s exige operandos int", no->valor);
+static void *cresce_pilha(void *p, size_t *cap, size_t tam)
+{
+    *cap = *cap ? 2 * *cap : 1024;
+    p = realloc(p, *cap * tam);
+    if (!p)
+    {
+        fprintf(stderr, "ERRO: memória insuficiente na análise semântica.\n");
+        exit(1);
+    }
+    return p;
+}
+
+static void empilha(Passo passo, NoId no, int aux)
+{
+    if (n_tarefas == cap_tarefas)
+        tarefas = cresce_pilha(tarefas, &cap_tarefas, sizeof *tarefas);
+    tarefas[n_tarefas].no = no;
+    tarefas[n_tarefas].passo = (uint8_t)passo;
+    tarefas[n_tarefas].aux = aux;
+    ++n_tarefas;
+}
 
-    return esq; /* tipo resultante */
+static void empilha_tipo(Tipo t)
+{
+    if (n_tipos == cap_tipos)
+        tipos = cresce_pilha(tipos, &cap_tipos, sizeof *tipos);
+    tipos[n_tipos++] = (uint8_t)t;
 }
 
-static Tipo verifica_expr(AST *expr)
+static Tipo desempilha_tipo(void)
 {
-    if (!expr)
-        return TIPO_INT;
+    return (Tipo)tipos[--n_tipos];
+}
+
+/* ========================================================= */
+/*  Verificação de expressões                               */
+/* ========================================================= */
 
-    switch (expr->tipo)
+/* Tipo calculado: fica na anotação do nó e na pilha de valores */
+static void resultado(NoId expr, Tipo t)
+{
+    ANOT(expr).tipo = (uint8_t)t;
+    empilha_tipo(t);
+}
+
+/* Primeira visita: folhas são resolvidas na hora; nós internos
+ * empilham o fechamento e depois os filhos (o primeiro no topo) */
+static void visita_expr(NoId expr)
+{
+    switch (TIPO(expr))
     {
     case AST_INT:
-        return TIPO_INT;
+        resultado(expr, TIPO_INT);
+        return;
     case AST_CAR:
-        return TIPO_CAR;
+        resultado(expr, TIPO_CAR);
+        return;
 
     case AST_ID:
     {
-        Simbolo *s = buscarSimbolo(expr->valor);
+        Simbolo *s = buscarSimbolo(NOME(expr));
         if (!s)
-            erro_semantico(expr->linha, "identificador %s não declarado", expr->valor);
-        return s->tipo;
+            erro_semantico(LINHA(expr), "identificador %s não declarado", NOME(expr));
+        if (s->categoria == FUNCAO)
+            erro_semantico(LINHA(expr), "função %s usada como variável", NOME(expr));
+        anota_nome(expr, s);
+        resultado(expr, s->tipo);
+        return;
     }
 
-    case AST_ATRIB:
+    case AST_CHAMADA_FUNCAO:
     {
-        /* filho[0] é ID, filho[1] é expressão */
-        AST *idNo = expr->filhos[0];
-        Tipo tvar = verifica_expr(idNo); /* faz lookup e devolve tipo da var */
-        Tipo texpr = verifica_expr(expr->filhos[1]);
+        Simbolo *f = buscarSimbolo(NOME(expr));
+        if (!f || f->categoria != FUNCAO)
+            erro_semantico(LINHA(expr), "função %s não declarada", NOME(expr));
+        anota_nome(expr, f);
 
-        if (tvar != texpr)
-            erro_semantico(expr->linha, "atribuição de tipos diferentes");
+        /* conta argumentos passados */
+        int n_args = NFILHOS(expr) > 0 ? NFILHOS(FILHO(expr, 0)) : 0;
+        if (n_args != f->numParametros)
+            erro_semantico(LINHA(expr), "número de parâmetros incorreto em %s", NOME(expr));
 
-        return tvar;
+        /* os tipos dos argumentos não são comparados com os dos
+         * parâmetros formais (extensão opcional) */
+        empilha(T_EXPR_FIM, expr, 0);
+        for (int i = n_args - 1; i >= 0; --i)
+            empilha(T_EXPR, FILHO(FILHO(expr, 0), i), 0);
+        return;
     }
 
+    case AST_ATRIB: /* filho[0] é ID, filho[1] é expressão */
     case AST_OP:
-    {
-        /* operadores aritméticos ou relacionais / lógicos */
-        if (!strcmp(expr->valor, "+") || !strcmp(expr->valor, "-") ||
-            !strcmp(expr->valor, "*") || !strcmp(expr->valor, "/"))
-        {
-            return verifica_operador_binario(expr, TIPO_INT);
-        }
-        else if (!strcmp(expr->valor, "<") || !strcmp(expr->valor, ">") ||
-                 !strcmp(expr->valor, "<=") || !strcmp(expr->valor, ">=") ||
-                 !strcmp(expr->valor, "==") || !strcmp(expr->valor, "!="))
-        {
-            /* relacionais – operandos mesmo tipo, resultado int */
-            Tipo esq = verifica_expr(expr->filhos[0]);
-            Tipo dir = verifica_expr(expr->filhos[1]);
-            if (esq != dir)
-                erro_semantico(expr->linha, "operandos incompatíveis em %s", expr->valor);
-            return TIPO_INT;
-        }
-        else if (!strcmp(expr->valor, "ou") || !strcmp(expr->valor, "e"))
+        empilha(T_EXPR_FIM, expr, 0);
+        for (int i = NFILHOS(expr) - 1; i >= 0; --i)
+            empilha(T_EXPR, FILHO(expr, i), 0);
+        return;
+
+    default: /* expressões agrupadoras – só vale o tipo do último filho */
+        if (NFILHOS(expr))
         {
-            /* lógicos – ambos int, resultado int */
-            verifica_operador_binario(expr, TIPO_INT);
-            return TIPO_INT;
+            empilha(T_EXPR_FIM, expr, 0);
+            empilha(T_EXPR, FILHO(expr, NFILHOS(expr) - 1), 0);
         }
-        else if (!strcmp(expr->valor, "uminus") || !strcmp(expr->valor, "!"))
+        else
         {
-            Tipo t = verifica_expr(expr->filhos[0]);
-            if (t != TIPO_INT)
-                erro_semantico(expr->linha, "operador %s requer int", expr->valor);
-            return TIPO_INT;
+            resultado(expr, TIPO_INT); /* fallback */
         }
-        break;
+        return;
     }
+}
 
-    case AST_CHAMADA_FUNCAO:
+static void verifica_operador_binario(NoId no, Tipo esq, Tipo dir, Tipo esperado)
+{
+    if (esq != dir)
+        erro_semantico(LINHA(no), "tipos incompatíveis no operador %s", OP_TEXTO[NO_OP(arv, no)]);
+
+    if (esperado != esq) /* para +,-,*,/ esperam int */
+        erro_semantico(LINHA(no), "operador %s exige operandos int", OP_TEXTO[NO_OP(arv, no)]);
+}
+
+/* Segunda visita: os tipos dos filhos estão no topo da pilha */
+static void fecha_expr(NoId expr)
+{
+    switch (TIPO(expr))
     {
-        Simbolo *f = buscarSimbolo(expr->valor);
-        if (!f || f->categoria != FUNCAO)
-            erro_semantico(expr->linha, "função %s não declarada", expr->valor);
+    case AST_ATRIB:
+    {
+        Tipo texpr = desempilha_tipo();
+        Tipo tvar = desempilha_tipo(); /* tipo da var (já resolvida) */
+        if (tvar != texpr)
+            erro_semantico(LINHA(expr), "atribuição de tipos diferentes");
+        resultado(expr, tvar);
+        return;
+    }
 
-        /* conta argumentos passados */
-        int n_args = (expr->n_filhos > 0 && expr->filhos[0])
-                         ? expr->filhos[0]->n_filhos
-                         : 0;
-        if (n_args != f->numParametros)
-            erro_semantico(expr->linha, "número de parâmetros incorreto em %s", expr->valor);
+    case AST_OP:
+    {
+        /* operadores aritméticos ou relacionais / lógicos */
+        ClasseOp classe = (ClasseOp)CLASSE_OP[NO_OP(arv, expr)];
+        if (classe == OPC_UNARIO)
+        {
+            Tipo t = desempilha_tipo();
+            if (t != TIPO_INT)
+                erro_semantico(LINHA(expr), "operador %s requer int", OP_TEXTO[NO_OP(arv, expr)]);
+            resultado(expr, TIPO_INT);
+            return;
+        }
 
-        /* verifica tipos de cada argumento (assume tabela tem ordem dos params) */
-        if (n_args)
+        Tipo dir = desempilha_tipo();
+        Tipo esq = desempilha_tipo();
+        switch (classe)
         {
-            AST *lista = expr->filhos[0];
-            for (int i = 0; i < n_args; ++i)
-            {
-                Tipo targ = verifica_expr(lista->filhos[i]);
-                /* busca tipo do parâmetro formal i (percorrendo lista ligada dos símbolos) */
-                /* simples: aceitar sempre, extensão opcional */
-            }
+        case OPC_ARITMETICO:
+        case OPC_LOGICO:
+            /* ambos int, resultado int */
+            verifica_operador_binario(expr, esq, dir, TIPO_INT);
+            break;
+
+        case OPC_RELACIONAL:
+            /* relacionais – operandos mesmo tipo, resultado int */
+            if (esq != dir)
+                erro_semantico(LINHA(expr), "operandos incompatíveis em %s", OP_TEXTO[NO_OP(arv, expr)]);
+            break;
+
+        case OPC_UNARIO:
+            break;
         }
-        return f->tipo;
+        resultado(expr, TIPO_INT);
+        return;
     }
 
-    default: /* expressões agrupadoras – só retorna tipo do último filho */
-        if (expr->n_filhos)
-            return verifica_expr(expr->filhos[expr->n_filhos - 1]);
+    case AST_CHAMADA_FUNCAO:
+        n_tipos -= NFILHOS(expr) > 0 ? NFILHOS(FILHO(expr, 0)) : 0;
+        resultado(expr, (Tipo)ANOT(expr).tipo); /* tipo de retorno */
+        return;
+
+    default:
+        resultado(expr, desempilha_tipo());
+        return;
     }
-    return TIPO_INT; /* fallback */
 }
 
 /* ========================================================= */
 /*  Verificação de comandos / blocos                         */
 /* ========================================================= */
 
-static void verifica_comando(AST *cmd)
+static void declara_variaveis(NoId listaDecl)
 {
-    if (!cmd)
+    if (listaDecl == NO_NULO)
         return;
-
-    switch (cmd->tipo)
+    for (int i = 0; i < NFILHOS(listaDecl); ++i)
     {
-    case AST_ATRIB:
-        verifica_expr(cmd); /* já valida */
-        break;
+        NoId var = FILHO(listaDecl, i);
+        if (TIPO(var) != AST_DECL_VARIAVEL)
+            continue;
+        const char *nome = NOME(var);
+        if (!nome)
+            erro_semantico(LINHA(var), "variável sem nome na AST");
+
+        Tipo t = tipo_do_no(FILHO(var, 0));
+        if (buscarSimbolo(nome) && buscarSimbolo(nome)->categoria != FUNCAO)
+            erro_semantico(LINHA(var), "identificador %s já declarado", nome);
+
+        ANOT(var).tipo = (uint8_t)t;
+        ANOT(var).lugar = LUGAR_FRAME;
+        ANOT(var).slot = proximoSlot;
+        inserirVariavel(nome, t, proximoSlot);
+        proximoSlot += WORD_SIZE;
+        if (proximoSlot > maiorSlot)
+            maiorSlot = proximoSlot;
+    }
+}
 
-    case AST_LEITURA:
+/* Expressão cujo valor não é usado (condição, atribuição, escreva) */
+static void empilha_expr_descartada(NoId expr)
+{
+    empilha(T_DESCARTA, expr, 0);
+    empilha(T_EXPR, expr, 0);
+}
+
+static void visita_comando(NoId cmd)
+{
+    switch (TIPO(cmd))
     {
-        AST *idNo = cmd->filhos[0];
-        verifica_expr(idNo); /* só garante que existe */
+    case AST_LEITURA:
+        empilha_expr_descartada(FILHO(cmd, 0)); /* só garante que existe */
         break;
-    }
 
     case AST_ESCRITA:
-        verifica_expr(cmd->filhos[0]);
+        empilha_expr_descartada(FILHO(cmd, 0));
         break;
 
     case AST_RETORNE:
-    {
-        Tipo t = verifica_expr(cmd->filhos[0]);
-        if (t != tipoFuncaoAtual)
-            erro_semantico(cmd->linha, "tipo do retorne diferente do tipo da função");
+        empilha(T_RETORNE, cmd, 0);
+        empilha(T_EXPR, FILHO(cmd, 0), 0);
         break;
-    }
 
     case AST_SE:
-    {
-        verifica_expr(cmd->filhos[0]);    /* condição */
-        verifica_comando(cmd->filhos[1]); /* then */
+    case AST_ENQUANTO:
+        empilha(T_COMANDO, FILHO(cmd, 1), 0); /* then / corpo */
+        empilha_expr_descartada(FILHO(cmd, 0)); /* condição */
         break;
-    }
 
     case AST_SENAO:
-    {
-        AST *ifNode = cmd->filhos[0];
-        verifica_comando(ifNode);
-        verifica_comando(cmd->filhos[1]); /* else */
+        empilha(T_COMANDO, FILHO(cmd, 1), 0); /* else */
+        empilha(T_COMANDO, FILHO(cmd, 0), 0); /* if   */
         break;
-    }
 
-    case AST_ENQUANTO:
+    case AST_BLOCO:
     {
-        verifica_expr(cmd->filhos[0]); /* condição */
-        verifica_comando(cmd->filhos[1]);
+        novoEscopo();
+        empilha(T_FECHA_BLOCO, cmd, proximoSlot);
+        declara_variaveis(FILHO(cmd, 0));
+        empilha(T_COMANDO, FILHO(cmd, 1), 0);
         break;
     }
 
-    case AST_BLOCO:
-        percorre_bloco(cmd);
+    case AST_LISTA_COMANDO:
+        for (int i = NFILHOS(cmd) - 1; i >= 0; --i)
+            empilha(T_COMANDO, FILHO(cmd, i), 0);
         break;
 
-    case AST_LISTA_COMANDO:
-        for (int i = 0; i < cmd->n_filhos; ++i)
-            verifica_comando(cmd->filhos[i]);
+    case AST_COMANDO:
+    case AST_NOVALINHA:
         break;
 
     default:
-        /* comando simples (;) já tratado */
+        /* atribuição ou outra expressão usada como comando, ex.: "f(x);" */
+        empilha_expr_descartada(cmd);
         break;
     }
 }
 
-static void declara_variaveis(AST *listaDecl)
+/* Executa as tarefas até esvaziar a pilha */
+static void executa(void)
 {
-    if (!listaDecl)
-        return;
-    for (int i = 0; i < listaDecl->n_filhos; ++i)
+    while (n_tarefas)
     {
-        AST *var = listaDecl->filhos[i];
-        if (!var || var->tipo != AST_DECL_VARIAVEL) continue;
-        if (!var)
-            continue;
-        if (var->tipo != AST_DECL_VARIAVEL)
-            continue;
-        if (!var->valor)
-            erro_semantico(var->linha, "variável sem nome na AST");
-
-        Tipo t = tipo_do_no(var->filhos[0]);
-        if (buscarSimbolo(var->valor) && buscarSimbolo(var->valor)->categoria != FUNCAO)
-            erro_semantico(var->linha, "identificador %s já declarado", var->valor);
-
-        inserirVariavel(var->valor, t, 0);
+        Tarefa t = tarefas[--n_tarefas];
+        switch ((Passo)t.passo)
+        {
+        case T_COMANDO:
+            visita_comando(t.no);
+            break;
+        case T_EXPR:
+            visita_expr(t.no);
+            break;
+        case T_EXPR_FIM:
+            fecha_expr(t.no);
+            break;
+        case T_DESCARTA:
+            --n_tipos;
+            break;
+        case T_RETORNE:
+            if (desempilha_tipo() != tipoFuncaoAtual)
+                erro_semantico(LINHA(t.no), "tipo do retorne diferente do tipo da função");
+            break;
+        case T_FECHA_BLOCO:
+            proximoSlot = t.aux; /* locais do bloco saem de vista */
+            removerEscopo();
+            break;
+        }
     }
 }
 
-static void percorre_bloco(AST *bloco)
+static void percorre_bloco(NoId bloco)
 {
-    novoEscopo();
-
-    AST *decls = bloco->filhos[0];
-    AST *stmts = bloco->filhos[1];
-
-    declara_variaveis(decls);
-    verifica_comando(stmts);
-
-    removerEscopo();
+    empilha(T_COMANDO, bloco, 0);
+    executa();
 }
 
 /* ========================================================= */
 /*  Verificação de funções e programa principal              */
 /* ========================================================= */
 
-static void verifica_funcao(AST *declFunc)
+static void verifica_funcao(NoId declFunc)
 {
-    const char *nome = declFunc->valor;
-    Tipo retTipo = tipo_do_no(declFunc->filhos[0]);
-    AST *fun = declFunc->filhos[1]; /* AST_FUNCAO */
+    const char *nome = NOME(declFunc);
+    Tipo retTipo = tipo_do_no(FILHO(declFunc, 0));
+    NoId fun = FILHO(declFunc, 1); /* AST_FUNCAO */
 
     /* --- declaração na tabela, se ainda não existir --- */
     Simbolo *s = buscarSimbolo(nome);
     if (s)
-        erro_semantico(declFunc->linha, "função %s duplicada", nome);
+        erro_semantico(LINHA(declFunc), "função %s duplicada", nome);
 
-    s = inserirFuncao(nome, retTipo,
-                      fun->filhos[0] ? fun->filhos[0]->n_filhos : 0);
+    NoId listaParam = FILHO(fun, 0);
+    s = inserirFuncao(nome, retTipo, NFILHOS(listaParam));
+    s->posicao = (int)declFunc; /* chamadas apontam para a declaração */
 
     /* --- novo escopo para parâmetros + variáveis locais --- */
     novoEscopo();
 
     /* insere parâmetros na tabela */
-    AST *listaParam = fun->filhos[0];
-    if (listaParam)
-        for (int i = 0; i < listaParam->n_filhos; ++i)
-        {
-            AST *param = listaParam->filhos[i]; /* AST_PARAM */
-            Tipo tp = tipo_do_no(param->filhos[0]);
-            const char *nomePar = param->filhos[1]->valor;
+    for (int i = 0; i < NFILHOS(listaParam); ++i)
+    {
+        NoId param = FILHO(listaParam, i); /* AST_PARAM */
+        Tipo tp = tipo_do_no(FILHO(param, 0));
+        const char *nomePar = NOME(FILHO(param, 1));
 
-            if (buscarSimbolo(nomePar))
-                erro_semantico(param->linha, "parâmetro %s duplicado", nomePar);
+        if (buscarSimbolo(nomePar))
+            erro_semantico(LINHA(param), "parâmetro %s duplicado", nomePar);
 
-            inserirParametro(nomePar, tp, i, s);
-        }
+        inserirParametro(nomePar, tp, i, s);
+        ANOT(param).tipo = (uint8_t)tp;
+        ANOT(param).lugar = LUGAR_FRAME;
+        ANOT(param).slot = slot_parametro(i);
+    }
 
     /* corpo da função */
     tipoFuncaoAtual = retTipo;
-    percorre_bloco(fun->filhos[1]); /* bloco */
+    inicia_frame(NFILHOS(listaParam));
+    percorre_bloco(FILHO(fun, 1)); /* bloco */
+    ANOT(declFunc).tipo = (uint8_t)retTipo;
+    ANOT(declFunc).slot = maiorSlot;
 
     removerEscopo();
 }
 
-static void verifica_programa(AST *raiz)
+static void verifica_programa(NoId raiz)
 {
     /* Estrutura: AST_PROGRAMA -> filhos[0] lista decl var/func
                                   filhos[1] programa principal */
 
-    AST *listaDecl = raiz->filhos[0];
-    AST *declProg = raiz->filhos[1];
+    NoId listaDecl = FILHO(raiz, 0);
+    NoId declProg = FILHO(raiz, 1);
 
     novoEscopo(); /* escopo global */
 
     /* --- var ou fun --- */
-    if (listaDecl)
-        for (int i = 0; i < listaDecl->n_filhos; ++i)
+    for (int i = 0; i < NFILHOS(listaDecl); ++i)
+    {
+        NoId item = FILHO(listaDecl, i);
+        if (TIPO(item) == AST_DECL_VARIAVEL)
         {
-            AST *item = listaDecl->filhos[i];
-            if (item->tipo == AST_DECL_VARIAVEL)
-            {
-                const char *nome = item->valor;
-                Tipo t = tipo_do_no(item->filhos[0]);
-                if (!nome)
-                    erro_semantico(item->linha, "variável global sem nome na AST (bug no parser)");
-                if (buscarSimbolo(nome))
-                    erro_semantico(item->linha, "variável %s duplicada", nome);
-                inserirVariavel(nome, t, 0);
-            }
-            else if (item->tipo == AST_DECL_FUNCAO)
-            {
-                verifica_funcao(item);
-            }
+            const char *nome = NOME(item);
+            Tipo t = tipo_do_no(FILHO(item, 0));
+            if (!nome)
+                erro_semantico(LINHA(item), "variável global sem nome na AST (bug no parser)");
+            if (buscarSimbolo(nome))
+                erro_semantico(LINHA(item), "variável %s duplicada", nome);
+            ANOT(item).tipo = (uint8_t)t;
+            ANOT(item).lugar = LUGAR_GLOBAL;
+            ANOT(item).slot = (int32_t)item;
+            inserirVariavel(nome, t, (int)item); /* rótulo vem da declaração */
         }
+        else if (TIPO(item) == AST_DECL_FUNCAO)
+        {
+            verifica_funcao(item);
+        }
+    }
 
     /* --- bloco principal 'programa' --- */
     tipoFuncaoAtual = TIPO_INT; /* não usado */
-    percorre_bloco(declProg->filhos[0]);
+    inicia_frame(0);
+    percorre_bloco(FILHO(declProg, 0));
+    ANOT(declProg).slot = maiorSlot;
 
     removerEscopo(); /* escopo global */
 }
@@ -359,10 +548,23 @@ static void verifica_programa(AST *raiz)
 /*  Função pública                                           */
 /* ========================================================= */
 
-int analise_semanica(AST *raiz)
+int analise_semanica(ASTC *a)
 {
-    if (!raiz)
+    if (!a || !a->n_nos)
         return 1;
-    verifica_programa(raiz);
+    free(a->anot);
+    a->anot = calloc(a->n_nos, sizeof *a->anot);
+    if (!a->anot)
+    {
+        fprintf(stderr, "ERRO: memória insuficiente para as anotações.\n");
+        exit(1);
+    }
+    arv = a;
+    verifica_programa(0);
+    free(tarefas);
+    free(tipos);
+    tarefas = NULL;
+    tipos = NULL;
+    n_tarefas = cap_tarefas = n_tipos = cap_tipos = 0;
     return 1; /* sucesso – não houve exit(1) */
 }
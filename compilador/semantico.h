@@ -3,7 +3,8 @@
 
 #include "ast.h"
 
-/* Retorna 1 se NÃO houver erro semântico, 0 caso contrário */
-int analise_semanica(AST *raiz);
+/* Retorna 1 se NÃO houver erro semântico, 0 caso contrário.
+ * Preenche arv->anot com o tipo e o endereço resolvido de cada nó. */
+int analise_semanica(ASTC *arv);
 
 #endif /* SEMANTICO_H */
@@ -1,36 +1,112 @@
+#include <stdio.h>
+#include <stdint.h>
 #include <stdlib.h>
-#include <string.h>
 #include "tabela_simbolos.h"
 
-static char *duplica(const char *s){
-    size_t n = strlen(s) + 1;
-    char *p  = malloc(n);
-    if(p) memcpy(p,s,n);
+/* ------------------------------------------------------------------
+ * Organização
+ *
+ *  - 'visiveis': hash com endereçamento aberto (sondagem linear),
+ *    indexada pelo ponteiro internado do nome; cada entrada aponta
+ *    para o símbolo mais interno com aquele nome. Nomes nunca saem da
+ *    hash: quando o último símbolo some, a entrada fica com s == NULL,
+ *    então não há lápides.
+ *  - 'pool': os Simbolo são tirados em ordem de inserção de blocos
+ *    fixos; o próprio pool serve de log de desfazer do escopo.
+ *  - 'marcas': para cada escopo aberto, o tamanho do pool na abertura.
+ *    removerEscopo() desfaz as inserções até a marca e devolve todos
+ *    os registros do escopo de uma vez.
+ * ------------------------------------------------------------------ */
+
+#define POOL_BLOCO 256
+
+typedef struct { const char *nome; Simbolo *s; } Entrada;
+
+static Entrada  *visiveis = NULL;
+static size_t    cap_hash = 0, usados_hash = 0;
+
+static Simbolo **pool = NULL;       /* blocos de POOL_BLOCO símbolos */
+static int       n_blocos = 0;
+static int       n_simbolos = 0;
+
+static int      *marcas = NULL;
+static int       cap_marcas = 0;
+static int       topo = -1;
+
+static void sem_memoria(void){
+    fprintf(stderr, "ERRO: memória insuficiente na tabela de símbolos.\n");
+    exit(1);
+}
+
+static void *realoca(void *p, size_t n){
+    p = realloc(p, n);
+    if(!p) sem_memoria();
     return p;
 }
 
-#define MAX_ESCOPOS 64
-static TabelaSimbolos pilha[MAX_ESCOPOS];
-static int topo = -1;
+static size_t hash_nome(const char *nome){
+    uintptr_t x = (uintptr_t)nome;
+    x ^= x >> 17;
+    x *= (uintptr_t)0x9E3779B97F4A7C15ull;
+    return (size_t)(x ^ (x >> 29));
+}
+
+static Entrada *procura(const char *nome){
+    size_t j = hash_nome(nome) & (cap_hash - 1);
+    while(visiveis[j].nome && visiveis[j].nome != nome)
+        j = (j + 1) & (cap_hash - 1);
+    return &visiveis[j];
+}
+
+static void cresce_hash(void){
+    Entrada *antiga = visiveis;
+    size_t cap_antiga = cap_hash;
+    cap_hash = cap_hash ? 2 * cap_hash : 256;
+    visiveis = calloc(cap_hash, sizeof *visiveis);
+    if(!visiveis) sem_memoria();
+    for(size_t i = 0; i < cap_antiga; ++i)
+        if(antiga[i].nome) *procura(antiga[i].nome) = antiga[i];
+    free(antiga);
+}
+
+static Simbolo *simbolo_do_pool(int i){
+    return &pool[i / POOL_BLOCO][i % POOL_BLOCO];
+}
 
 void novoEscopo(void){
-    if(++topo >= MAX_ESCOPOS) exit(1);
-    pilha[topo].lista = NULL;
+    if(++topo >= cap_marcas){
+        cap_marcas = cap_marcas ? 2 * cap_marcas : 64;
+        marcas = realoca(marcas, cap_marcas * sizeof *marcas);
+    }
+    marcas[topo] = n_simbolos;
 }
 
 void removerEscopo(void){
     if(topo < 0) return;
-    Simbolo *s = pilha[topo].lista, *tmp;
-    while(s){ tmp = s->prox; free(s->nome); free(s); s = tmp; }
+    for(int i = n_simbolos - 1; i >= marcas[topo]; --i){
+        Simbolo *s = simbolo_do_pool(i);
+        procura(s->nome)->s = s->sombra;
+    }
+    n_simbolos = marcas[topo];   /* blocos ficam para reuso */
     --topo;
 }
 
 static Simbolo *cria(const char *nome, Tipo t, Categoria c){
-    Simbolo *s = malloc(sizeof *s);
-    s->nome = duplica(nome);
+    if(n_simbolos == n_blocos * POOL_BLOCO){
+        pool = realoca(pool, (n_blocos + 1) * sizeof *pool);
+        pool[n_blocos++] = realoca(NULL, POOL_BLOCO * sizeof(Simbolo));
+    }
+    Simbolo *s = simbolo_do_pool(n_simbolos++);
+
+    if((usados_hash + 1) * 2 > cap_hash) cresce_hash();
+    Entrada *e = procura(nome);
+    if(!e->nome){ e->nome = nome; ++usados_hash; }
+
+    s->nome = nome;
     s->tipo = t; s->categoria = c;
-    s->prox = pilha[topo].lista;
-    pilha[topo].lista = s;
+    s->escopo = topo;
+    s->sombra = e->s;
+    e->s = s;
     return s;
 }
 
@@ -51,8 +127,6 @@ void inserirParametro(const char *nome, Tipo t, int pos, Simbolo *f){
 }
 
 Simbolo *buscarSimbolo(const char *nome){
-    for(int i=topo;i>=0;--i)
-        for(Simbolo *s = pilha[i].lista; s; s = s->prox)
-            if(strcmp(s->nome,nome)==0) return s;
-    return NULL;
+    if(!cap_hash) return NULL;
+    return procura(nome)->s;
 }
@@ -5,20 +5,21 @@ typedef enum { TIPO_INT, TIPO_CAR } Tipo;
 typedef enum { VARIAVEL, FUNCAO, PARAMETRO } Categoria;
 
 typedef struct Simbolo {
-    char      *nome;
+    const char *nome;     /* ponteiro internado (intern.h) */
     Tipo       tipo;
     Categoria  categoria;
     int        posicao;
     int        numParametros;
+    int        escopo;    /* nível do escopo (0 = global) */
     struct Simbolo *funcaoRef;
-    struct Simbolo *prox;
+    struct Simbolo *sombra;  /* mesmo nome num escopo externo, ou NULL */
 } Simbolo;
 
-typedef struct TabelaSimbolos {
-    Simbolo *lista;
-} TabelaSimbolos;
-
-
+/* Todos os nomes recebidos devem vir de intern(): a tabela guarda o
+ * ponteiro e compara nomes por igualdade de ponteiro.
+ *
+ * Os Simbolo* devolvidos só valem enquanto o escopo que os criou
+ * estiver aberto: removerEscopo() devolve os registros ao pool. */
 void   novoEscopo(void);
 void   removerEscopo(void);
 void   inserirVariavel(const char *nome, Tipo t, int pos);